@@ -0,0 +1,185 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <map>
+#include "common/types.h"
+
+// Where in-flight results live until commit
+enum class RenameMode {
+    ROB,        // Results held in ROB entries, operands tagged by ROB index
+    MERGED      // Merged physical register file with alias table and free list
+};
+
+// Order in which ready instructions compete for functional units
+enum class SelectPolicy {
+    OLDEST_FIRST,     // Program order (ROB age)
+    LOADS_FIRST,      // Loads ahead of everything else, then by age
+    CRITICAL_PATH     // Most waiting dependents first, then by age
+};
+
+// How loads are ordered against older stores with unknown addresses
+enum class MemDepPolicy {
+    CONSERVATIVE,     // Wait until every older store address is known
+    SPECULATIVE,      // Always run ahead; replay on an ordering violation
+    STORE_SETS        // Run ahead unless the store-set predictor says to wait
+};
+
+// Cache line replacement policy
+enum class ReplacementPolicy {
+    LRU,        // True least-recently-used
+    PLRU,       // Tree pseudo-LRU
+    RRIP        // Static re-reference interval prediction (2-bit)
+};
+
+// Hardware data prefetcher attached to a cache
+enum class PrefetcherType {
+    NONE,
+    NEXT_LINE,  // Lines following a miss
+    STRIDE,     // Per-load-PC constant stride
+    STREAM      // Sequential miss streams in either direction
+};
+
+// Geometry and timing of one cache level
+struct CacheConfig {
+    unsigned int size;                // Capacity in bytes
+    unsigned int ways;                // Associativity
+    unsigned int line_size;           // Line size in bytes
+    ReplacementPolicy replacement;    // Victim selection
+    unsigned int hit_latency;         // Cycles for a hit
+    unsigned int mshrs;               // Outstanding line fills (miss status holding registers)
+};
+
+// Main memory timing, in processor cycles
+struct DramConfig {
+    unsigned int banks;        // Independent banks
+    unsigned int row_size;     // Bytes per row (row buffer size)
+    unsigned int t_rcd;        // Activate to column command
+    unsigned int t_cas;        // Column command to data
+    unsigned int t_rp;         // Precharge
+    unsigned int t_burst;      // Data transfer for one line
+    unsigned int queue_size;   // Requests the controller can hold
+};
+
+// One level of translation lookaside buffer
+struct TlbConfig {
+    unsigned int entries;
+    unsigned int ways;
+    unsigned int hit_latency;   // Extra cycles on a hit (0: overlapped with the cache lookup)
+};
+
+// Micro-op cache of decoded fetch blocks
+struct UopCacheConfig {
+    unsigned int entries;          // Fetch blocks held (0: no micro-op cache)
+    unsigned int ways;             // Associativity
+    unsigned int width;            // Packets delivered per cycle, from up to two blocks
+    unsigned int switch_penalty;   // Cycles lost switching between the cache and the decoders
+};
+
+// One class of functional units
+struct FunctionalUnitConfig {
+    unsigned int count;     // Number of units
+    unsigned int latency;   // Cycles from issue to result broadcast
+    bool pipelined;         // Accepts a new operation every cycle
+};
+
+// Microarchitectural parameters shared by the pipeline stages
+struct ProcessorConfig {
+    // Instructions fetched, decoded and dispatched per cycle
+    unsigned int pipeline_width = 4;
+    
+    // Fetch blocks the branch predictor may queue ahead of fetch
+    unsigned int ftq_size = 8;
+    
+    // Fuse common adjacent instruction pairs into single ops at decode
+    bool macro_fusion = false;
+    
+    // Micro-op cache in front of dispatch, bypassing instruction fetch and decode
+    UopCacheConfig uop_cache = {0, 8, 6, 1};
+    
+    // Decoded instructions buffered in front of dispatch
+    unsigned int instruction_queue_size = 16;
+    
+    // Instructions retired from the ROB head per cycle
+    unsigned int commit_width = 4;
+    
+    // Reorder buffer entries
+    unsigned int rob_size = 16;
+    
+    // Load queue and store queue entries
+    unsigned int load_queue_size = 8;
+    unsigned int store_queue_size = 8;
+    
+    // Post-commit store buffer: lines held and cycles between line writes
+    unsigned int store_buffer_size = 8;
+    unsigned int store_buffer_drain_interval = 1;
+    
+    // Memory dependence prediction
+    MemDepPolicy mem_dep_policy = MemDepPolicy::STORE_SETS;
+    unsigned int ssit_size = 1024;
+    unsigned int lfst_size = 128;
+    
+    // Load value prediction: predictor entries and the number of repeated
+    // strides (at most 7) before a load's value is predicted
+    bool value_prediction = false;
+    unsigned int lvp_entries = 1024;
+    unsigned int lvp_confidence = 7;
+    
+    // Register renaming scheme
+    RenameMode rename_mode = RenameMode::ROB;
+    
+    // Resolve moves and zero idioms at rename instead of executing them
+    bool rename_elimination = false;
+    
+    // Physical registers in merged mode (including the 32 architectural homes)
+    unsigned int num_phys_regs = 64;
+    
+    // Alias table checkpoints available to in-flight control instructions
+    unsigned int rat_checkpoints = 8;
+    
+    // Functional unit pools
+    FunctionalUnitConfig alu_units = {3, 1, true};
+    FunctionalUnitConfig agu_units = {2, 1, true};
+    FunctionalUnitConfig branch_units = {1, 1, true};
+    
+    // Multiplier and iterative divider, fed from the ALU reservation station.
+    // The divider latency is for a full 64-bit quotient; it stops early
+    // when the quotient has fewer significant bits.
+    FunctionalUnitConfig mul_units = {1, 3, true};
+    FunctionalUnitConfig div_units = {1, 20, false};
+    
+    // Per-opcode latencies replacing the unit class latency (M extension
+    // operations keep the multiplier and divider latencies)
+    std::map<Opcode, unsigned int> opcode_latency;
+    
+    // Issue select policy
+    SelectPolicy select_policy = SelectPolicy::OLDEST_FIRST;
+    
+    // First-level instruction and data caches
+    CacheConfig l1i = {32768, 8, 64, ReplacementPolicy::LRU, 1, 4};
+    CacheConfig l1d = {32768, 8, 64, ReplacementPolicy::LRU, 2, 8};
+    
+    // Unified second-level cache shared by the L1s
+    CacheConfig l2 = {262144, 8, 64, ReplacementPolicy::LRU, 12, 16};
+    
+    // Data prefetchers and how many lines each trigger requests
+    PrefetcherType l1d_prefetcher = PrefetcherType::NONE;
+    PrefetcherType l2_prefetcher = PrefetcherType::NONE;
+    unsigned int prefetch_degree = 2;
+    
+    // Main memory behind the L2
+    DramConfig dram = {8, 2048, 14, 14, 14, 4, 16};
+    
+    // Sv39 address translation and the page size the OS model maps with:
+    // 12 (4 KB), 21 (2 MB megapages) or 30 (1 GB gigapages)
+    bool virtual_memory = false;
+    unsigned int page_shift = 12;
+    
+    // Split first-level TLBs, unified second-level TLB, and the page walk
+    // cache that lets the walker skip upper page-table levels
+    TlbConfig itlb = {32, 4, 0};
+    TlbConfig dtlb = {64, 4, 0};
+    TlbConfig l2tlb = {1024, 8, 7};
+    unsigned int pwc_entries = 16;
+};
+
+#endif // CONFIG_H
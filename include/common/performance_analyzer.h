@@ -5,9 +5,11 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <chrono>
 #include <fstream>
 #include "common/types.h"
+#include "common/symbol_table.h"
 
 // Structure to hold instruction statistics
 struct InstructionStats {
@@ -23,6 +25,79 @@ struct InstructionStats {
           cycles_in_execute(0), cycles_in_writeback(0), memory_accesses(0) {}
 };
 
+// Per-cache access counters
+struct CacheStats {
+    uint64_t accesses;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t writebacks;   // Dirty lines evicted
+    
+    // Miss status holding registers
+    uint64_t mshr_merges;          // Secondary misses merged into an outstanding fill
+    uint64_t mshr_full;            // Accesses turned away because every MSHR was busy
+    uint64_t mshr_busy_cycles;     // Cycles with at least one miss outstanding
+    uint64_t mshr_occupancy_sum;   // Outstanding misses summed over busy cycles
+    unsigned int mshr_peak;
+    
+    CacheStats()
+        : accesses(0), hits(0), misses(0), evictions(0), writebacks(0),
+          mshr_merges(0), mshr_full(0), mshr_busy_cycles(0), mshr_occupancy_sum(0),
+          mshr_peak(0) {}
+};
+
+// Per-cache prefetcher counters
+struct PrefetchStats {
+    uint64_t issued;     // Lines requested by the prefetcher
+    uint64_t useful;     // Prefetched lines later referenced by a demand access
+    uint64_t late;       // Useful prefetches still in flight when referenced
+    uint64_t unused;     // Prefetched lines evicted without a reference
+    uint64_t dropped;    // Requests discarded for lack of an MSHR
+    
+    PrefetchStats()
+        : issued(0), useful(0), late(0), unused(0), dropped(0) {}
+};
+
+// Per-TLB lookup counters
+struct TlbStats {
+    uint64_t accesses;
+    uint64_t hits;
+    uint64_t misses;
+    
+    TlbStats() : accesses(0), hits(0), misses(0) {}
+};
+
+// Reasons dispatch can stop partway through a group
+enum class DispatchStall {
+    ROB_FULL,         // No free reorder buffer entry
+    RS_ALU_FULL,      // ALU reservation station full
+    RS_MEM_FULL,      // Memory reservation station full
+    RS_BRANCH_FULL,   // Branch reservation station full
+    LQ_FULL,          // Load queue full
+    SQ_FULL,          // Store queue full
+    FREE_LIST_EMPTY,  // No free physical register (merged rename mode)
+    CHECKPOINTS_FULL  // No alias table checkpoint for a control instruction
+};
+
+// Why the ROB head could not retire in a cycle
+enum class RetireStall {
+    ROB_EMPTY,        // Nothing to retire
+    HEAD_ALU,         // Head is an ALU instruction still executing
+    HEAD_LOAD,        // Head is a load waiting for its data
+    HEAD_STORE,       // Head is a store waiting for its address/data
+    HEAD_BRANCH,      // Head is a branch or jump not yet resolved
+    STORE_BUFFER_FULL,// Head is a store and the store buffer has no room
+    COMMIT_WIDTH      // Head was ready but the commit width was used up
+};
+
+// Where the dispatch slots left empty in a cycle went (top-down accounting)
+enum class SlotLoss {
+    FRONTEND,         // Nothing decoded to dispatch
+    RECOVERY,         // Nothing to dispatch while fetch refills after a squash
+    BACKEND_MEMORY,   // Dispatch blocked behind a load or store
+    BACKEND_CORE      // Dispatch blocked by any other full resource
+};
+
 // Performance analyzer class
 class PerformanceAnalyzer : public sc_module {
 public:
@@ -45,8 +120,103 @@ public:
     void record_data_hazard();
     void record_control_hazard();
     void record_structural_hazard();
+    void record_structural_hazard(DispatchStall reason);
     void record_pipeline_flush();
     
+    // Record load/store queue events
+    void record_store_forward();
+    void record_load_blocked();
+    void record_memory_order_violation();
+    void record_memory_dependence_wait();
+    
+    // Record a load looked up in the value predictor (predicted if confident)
+    void record_value_lookup(bool predicted);
+    
+    // Record a predicted load value checked against the data it read
+    void record_value_prediction(bool correct);
+    
+    // Record store buffer activity
+    void record_store_buffer_insert(bool combined);
+    void record_store_buffer_occupancy(unsigned int lines);
+    
+    // Record cache lookups and line evictions, keyed by cache name
+    void record_cache_access(const std::string& cache, bool hit);
+    void record_cache_eviction(const std::string& cache, bool dirty);
+    
+    // Record miss status holding register activity, keyed by cache name
+    void record_mshr_merge(const std::string& cache);
+    void record_mshr_full(const std::string& cache);
+    void record_mshr_occupancy(const std::string& cache, unsigned int outstanding);
+    
+    // Record prefetcher activity, keyed by the cache it fills
+    void record_prefetch_issued(const std::string& cache);
+    void record_prefetch_useful(const std::string& cache, bool late);
+    void record_prefetch_unused(const std::string& cache);
+    void record_prefetch_dropped(const std::string& cache);
+    
+    // Record a DRAM line transfer and how long it took
+    void record_dram_access(RowBufferOutcome outcome, bool is_write, unsigned int latency, bool queued);
+    
+    // Record a TLB lookup, keyed by TLB name
+    void record_tlb_access(const std::string& tlb, bool hit);
+    
+    // Record a page walk: PTEs read from memory and cycles spent walking
+    void record_page_walk(unsigned int pte_reads, unsigned int latency);
+    
+    // Record the latency of a data cache access seen by the core
+    void record_data_latency(unsigned int cycles);
+    
+    // Sample fetch target queue occupancy
+    void record_ftq_occupancy(unsigned int entries, unsigned int capacity);
+    
+    // Record a fetch block delivered to decode: its instructions, how many
+    // of them are compressed, and the bytes they occupy
+    void record_fetch_block(unsigned int instructions, unsigned int compressed, unsigned int bytes);
+    
+    // Record an instruction pair fused into one op by decode
+    void record_fusion(FusionKind kind);
+    
+    // Record a fetch block served by the micro-op cache (hit) or the decoders
+    void record_uop_lookup(bool hit);
+    
+    // Record a cycle delivering packets (covering the given number of
+    // instructions, fused pairs counting twice) from the micro-op cache
+    void record_uop_delivery(unsigned int packets, unsigned int instructions);
+    
+    // Record a switch between the micro-op cache and the decoders
+    void record_uop_switch(unsigned int penalty);
+    
+    // Record the number of instructions dispatched in a cycle
+    void record_dispatch(unsigned int count);
+    
+    // Record a cycle's dispatch slots: those used and why the rest were not
+    void record_dispatch_slots(unsigned int used, unsigned int width, SlotLoss lost);
+    
+    // Record dispatched instructions discarded by a squash
+    void record_squashed(unsigned int count);
+    
+    // Record an instruction resolved at rename instead of executing
+    void record_elimination(EliminationKind kind);
+    
+    // Record the number of instructions retired in a cycle
+    void record_retire(unsigned int count);
+    
+    // Attribute retired instructions to functions of the loaded program
+    void set_symbol_table(const SymbolTable* table) { symbols = table; }
+    void record_retired_pc(Address pc);
+    
+    // Record why retirement stopped at the ROB head in a cycle
+    void record_retire_stall(RetireStall reason);
+    
+    // Sample physical register file occupancy (merged rename mode)
+    void record_register_occupancy(unsigned int allocated, unsigned int total);
+    
+    // Record operations started on a class of functional units in a cycle
+    void record_fu_issue(FUType type, unsigned int issued, unsigned int units);
+    
+    // Record a cycle in which ready operations waited for a busy unit class
+    void record_fu_stall(FUType type);
+    
     // Generate reports
     void print_summary() const;
     void generate_detailed_report(const std::string& filename) const;
@@ -74,18 +244,125 @@ private:
     uint64_t total_memory_reads;
     uint64_t total_memory_writes;
     
+    // Load/store queue statistics
+    uint64_t store_forwards;
+    uint64_t load_blocks;
+    uint64_t memory_order_violations;
+    uint64_t memory_dependence_waits;
+    
+    // Load value prediction
+    uint64_t value_lookups;
+    uint64_t value_predictions;
+    uint64_t value_validated;
+    uint64_t value_correct;
+    
+    // Store buffer statistics
+    uint64_t store_buffer_inserts;
+    uint64_t store_buffer_combined;
+    uint64_t store_buffer_samples;
+    uint64_t store_buffer_occupancy_sum;
+    unsigned int store_buffer_occupancy_max;
+    
+    // Cache statistics
+    std::map<std::string, CacheStats> cache_stats;
+    std::map<std::string, PrefetchStats> prefetch_stats;
+    
+    // DRAM statistics
+    uint64_t dram_reads;
+    uint64_t dram_writes;
+    uint64_t dram_read_latency_sum;
+    uint64_t dram_queue_full;
+    std::map<RowBufferOutcome, uint64_t> row_buffer_outcomes;
+    
+    // Address translation statistics
+    std::map<std::string, TlbStats> tlb_stats;
+    uint64_t page_walks;
+    uint64_t page_walk_pte_reads;
+    uint64_t page_walk_latency_sum;
+    
+    // Data access latency, bucket i counts latencies in [2^i, 2^(i+1))
+    std::vector<uint64_t> data_latency_histogram;
+    
+    // Fetch target queue occupancy
+    uint64_t ftq_samples;
+    uint64_t ftq_occupancy_sum;
+    uint64_t ftq_full_cycles;
+    unsigned int ftq_occupancy_max;
+    unsigned int ftq_capacity;
+    
+    // Fetch blocks delivered to decode
+    uint64_t fetch_blocks;
+    uint64_t fetch_block_instructions;
+    uint64_t fetch_block_bytes;
+    uint64_t compressed_instructions;
+    
+    // Macro-op fusion: fused pairs delivered by decode or the micro-op cache, by idiom
+    std::map<FusionKind, uint64_t> fusions;
+    uint64_t fused_pairs;
+    
+    // Micro-op cache
+    uint64_t uop_lookups;
+    uint64_t uop_hits;
+    uint64_t uop_delivery_cycles;
+    uint64_t uop_packets;
+    uint64_t uop_instructions;
+    uint64_t uop_switches;
+    uint64_t uop_switch_cycles;
+    
     // Hazard statistics
     uint64_t data_hazards;
     uint64_t control_hazards;
     uint64_t structural_hazards;
     uint64_t pipeline_flushes;
     
+    // Dispatch statistics
+    std::map<DispatchStall, uint64_t> dispatch_stalls;
+    std::vector<uint64_t> dispatch_histogram;  // Cycles indexed by instructions dispatched
+    uint64_t moves_eliminated;
+    uint64_t zero_idioms_eliminated;
+    
+    // Top-down slot accounting: slots dispatched into, later squashed, and
+    // left empty by cause; retiring slots are the dispatched minus the squashed
+    uint64_t slots_total;
+    uint64_t slots_used;
+    uint64_t slots_squashed;
+    std::map<SlotLoss, uint64_t> slot_losses;
+    
+    // Retire statistics
+    uint64_t total_retired;
+    std::map<RetireStall, uint64_t> retire_stalls;
+    std::vector<uint64_t> retire_histogram;    // Cycles indexed by instructions retired
+    
+    // Physical register file occupancy
+    uint64_t prf_samples;
+    uint64_t prf_allocated_sum;
+    unsigned int prf_allocated_max;
+    unsigned int prf_size;
+    
+    // Functional unit statistics
+    std::map<FUType, uint64_t> fu_ops;
+    std::map<FUType, uint64_t> fu_stalls;
+    std::map<FUType, unsigned int> fu_units;
+    
+    // Retired instructions per PC, counted only when symbols are available
+    const SymbolTable* symbols;
+    std::unordered_map<Address, uint64_t> retired_pcs;
+    
     // Helper methods
     void initialize_stats();
     Opcode extract_opcode(Instruction inst);
     InstructionType get_instruction_type(Opcode opcode);
     std::string opcode_to_string(Opcode opcode) const;
     std::string type_to_string(InstructionType type) const;
+    uint64_t slot_loss(SlotLoss loss) const;
+    std::string dispatch_stall_to_string(DispatchStall reason) const;
+    std::string retire_stall_to_string(RetireStall reason) const;
+    std::string fu_type_to_string(FUType type) const;
+    std::string fusion_kind_to_string(FusionKind kind) const;
+    std::string row_buffer_outcome_to_string(RowBufferOutcome outcome) const;
+    
+    // Retired instructions summed per function, hottest first
+    std::vector<std::pair<std::string, uint64_t>> function_profile() const;
 };
 
 #endif // PERFORMANCE_ANALYZER_H
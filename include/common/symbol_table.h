@@ -0,0 +1,31 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <map>
+#include <string>
+#include "common/types.h"
+
+// Program symbols by address, used to attribute PCs to functions in reports
+class SymbolTable {
+public:
+    // Add a symbol; size 0 means it extends to the next symbol
+    void add(const std::string& name, Address addr, uint64_t size);
+    
+    // Name of the symbol covering addr, or nullptr if none does
+    const std::string* lookup(Address addr) const;
+    
+    bool empty() const { return symbols.empty(); }
+    size_t size() const { return symbols.size(); }
+    void clear() { symbols.clear(); }
+    
+private:
+    struct Symbol {
+        std::string name;
+        uint64_t size;
+    };
+    
+    // Start address -> symbol
+    std::map<Address, Symbol> symbols;
+};
+
+#endif // SYMBOL_TABLE_H
@@ -36,6 +36,10 @@ enum class Opcode {
     OP_IMM = 0b0010011,   // Register-Immediate operations
     OP     = 0b0110011,   // Register-Register operations
     SYSTEM = 0b1110011,   // System instructions
+    
+    // RV64I additions
+    OP_IMM_32 = 0b0011011,  // Register-Immediate word operations (ADDIW, SLLIW, ...)
+    OP_32     = 0b0111011,  // Register-Register word operations (ADDW, SUBW, ...)
     UNKNOWN
 };
 
@@ -53,13 +57,16 @@ enum class Funct3 {
     LB  = 0b000,    // Load Byte
     LH  = 0b001,    // Load Halfword
     LW  = 0b010,    // Load Word
+    LD  = 0b011,    // Load Doubleword (RV64)
     LBU = 0b100,    // Load Byte Unsigned
     LHU = 0b101,    // Load Halfword Unsigned
+    LWU = 0b110,    // Load Word Unsigned (RV64)
     
     // Store operations
     SB = 0b000,     // Store Byte
     SH = 0b001,     // Store Halfword
     SW = 0b010,     // Store Word
+    SD = 0b011,     // Store Doubleword (RV64)
     
     // Register-Immediate operations
     ADDI  = 0b000,  // Add Immediate
@@ -84,13 +91,58 @@ enum class Funct3 {
     OR   = 0b110,   // OR
     AND  = 0b111,   // AND
     
+    // Multiply/divide operations (M extension, funct7 = 1)
+    MUL    = 0b000, // Multiply, low bits
+    MULH   = 0b001, // Multiply high, signed x signed
+    MULHSU = 0b010, // Multiply high, signed x unsigned
+    MULHU  = 0b011, // Multiply high, unsigned x unsigned
+    DIV    = 0b100, // Divide, signed
+    DIVU   = 0b101, // Divide, unsigned
+    REM    = 0b110, // Remainder, signed
+    REMU   = 0b111, // Remainder, unsigned
+    
     UNKNOWN
 };
 
+// Functional unit classes
+enum class FUType {
+    ALU,       // Integer arithmetic and logic
+    AGU,       // Address generation and memory access
+    BRANCH,    // Branches and jumps
+    MUL,       // Integer multiply
+    DIV        // Integer divide and remainder
+};
+
+// Adjacent instruction pairs decode fuses into one internal op
+enum class FusionKind {
+    NONE,
+    LOAD_IMMEDIATE,   // lui + addi/addiw: rd = constant
+    PC_RELATIVE,      // auipc + addi: rd = pc + offset
+    CALL,             // auipc + jalr: pc-relative call
+    SHIFT_EXTEND,     // slli + srli/srai: zero/sign extension and field extract
+    COMPARE_BRANCH    // slt/sltu + beqz/bnez on the result
+};
+
+// Instructions resolved at rename, without a reservation station entry or
+// a functional unit
+enum class EliminationKind {
+    NONE,
+    MOVE,             // addi rd, rs, 0 / add rd, x0, rs: rd takes rs's value
+    ZERO_IDIOM        // xor/sub rd, rs, rs / addi rd, x0, imm: result known at rename
+};
+
+// State of a DRAM bank's row buffer when a request reaches it
+enum class RowBufferOutcome {
+    HIT,       // Requested row already open
+    EMPTY,     // No row open; activate only
+    CONFLICT   // Another row open; precharge then activate
+};
+
 // Pipeline packets
 struct FetchPacket {
     Instruction instruction;
     Address pc;
+    Address predicted_pc;  // Next PC predicted by fetch
     bool valid;
 };
 
@@ -105,9 +157,28 @@ struct DecodePacket {
     uint8_t rs2;
     uint8_t rd;
     int32_t imm;
+    uint8_t length;        // Instruction size in bytes (2 if compressed)
+    Address predicted_pc;  // Next PC predicted by fetch
+    FusionKind fusion;     // Pair this packet stands for, if fused
+    int32_t imm2;          // Second shift amount or compare funct3 of a fused pair
     bool valid;
 };
 
+// Maximum number of instructions moved between stages in one cycle
+const unsigned int MAX_PIPELINE_WIDTH = 8;
+
+// Fetch group handed to decode; count == 0 is a bubble
+struct FetchBundle {
+    FetchPacket packets[MAX_PIPELINE_WIDTH];
+    uint8_t count;
+};
+
+// Decode group handed to dispatch; count == 0 is a bubble
+struct DecodeBundle {
+    DecodePacket packets[MAX_PIPELINE_WIDTH];
+    uint8_t count;
+};
+
 struct ExecutePacket {
     Instruction instruction;
     Address pc;
@@ -122,6 +193,12 @@ struct ExecutePacket {
     bool valid;
 };
 
+// Branches resolved in one cycle, reported to the predictor; count == 0 is a bubble
+struct ExecuteBundle {
+    ExecutePacket packets[MAX_PIPELINE_WIDTH];
+    uint8_t count;
+};
+
 // Reservation Station entry
 struct RSEntry {
     bool busy;
@@ -131,10 +208,13 @@ struct RSEntry {
     uint8_t rd;
     RegisterValue Vj;  // Value of operand 1
     RegisterValue Vk;  // Value of operand 2
-    uint8_t Qj;        // Reservation station producing operand 1 (0 if value available)
-    uint8_t Qk;        // Reservation station producing operand 2 (0 if value available)
+    uint16_t Qj;       // Tag of the producer of operand 1 (0 if value available)
+    uint16_t Qk;       // Tag of the producer of operand 2 (0 if value available)
     int32_t imm;       // Immediate value if needed
     Address pc;        // Program counter
+    uint8_t length;    // Instruction size in bytes, for the fall-through PC
+    FusionKind fusion; // Fused pair this entry executes, if any
+    int32_t imm2;      // Second shift amount or compare funct3 of a fused pair
     bool ready;        // Ready to execute
 };
 
@@ -148,13 +228,22 @@ struct ROBEntry {
     Address mem_addr;
     RegisterValue mem_data;
     Address pc;
+    Opcode opcode;     // Opcode of the instruction occupying the entry
     Funct3 funct3;     // Function code for store operations
+    Address predicted_pc;  // Next PC predicted by fetch, checked when a branch resolves
+    int phys_dest;     // Physical destination register (merged rename mode, -1 if none)
+    int old_phys_dest; // Previous mapping of dest, freed at commit (merged rename mode)
+    int checkpoint;    // Rename checkpoint held by a control instruction (-1 if none)
+    FusionKind fusion; // Fused pairs retire as two instructions
+    int move_tag;      // Result tag an eliminated move is waiting on (0 if none)
+    bool value_predicted;          // Load whose consumers were given predicted_value
+    RegisterValue predicted_value;
 };
 
 // Register Status
 struct RegisterStatus {
     bool busy;         // Whether register is waiting for a result
-    uint8_t rob_entry; // ROB entry that will produce result
+    uint16_t rob_entry; // ROB entry that will produce result
 };
 
 // Stream insertion operator for FetchPacket
@@ -162,6 +251,7 @@ inline std::ostream& operator<<(std::ostream& os, const FetchPacket& packet) {
     os << "FetchPacket{" 
        << "instruction=" << std::hex << packet.instruction << std::dec
        << ", pc=0x" << std::hex << packet.pc << std::dec
+       << ", predicted_pc=0x" << std::hex << packet.predicted_pc << std::dec
        << ", valid=" << (packet.valid ? "true" : "false")
        << "}";
     return os;
@@ -171,6 +261,7 @@ inline std::ostream& operator<<(std::ostream& os, const FetchPacket& packet) {
 inline bool operator==(const FetchPacket& lhs, const FetchPacket& rhs) {
     return lhs.instruction == rhs.instruction &&
            lhs.pc == rhs.pc &&
+           lhs.predicted_pc == rhs.predicted_pc &&
            lhs.valid == rhs.valid;
 }
 
@@ -187,6 +278,10 @@ inline std::ostream& operator<<(std::ostream& os, const DecodePacket& packet) {
        << ", rs2=" << static_cast<int>(packet.rs2)
        << ", rd=" << static_cast<int>(packet.rd)
        << ", imm=" << packet.imm
+       << ", length=" << static_cast<int>(packet.length)
+       << ", predicted_pc=0x" << std::hex << packet.predicted_pc << std::dec
+       << ", fusion=" << static_cast<int>(packet.fusion)
+       << ", imm2=" << packet.imm2
        << ", valid=" << (packet.valid ? "true" : "false")
        << "}";
     return os;
@@ -204,6 +299,10 @@ inline bool operator==(const DecodePacket& lhs, const DecodePacket& rhs) {
            lhs.rs2 == rhs.rs2 &&
            lhs.rd == rhs.rd &&
            lhs.imm == rhs.imm &&
+           lhs.length == rhs.length &&
+           lhs.predicted_pc == rhs.predicted_pc &&
+           lhs.fusion == rhs.fusion &&
+           lhs.imm2 == rhs.imm2 &&
            lhs.valid == rhs.valid;
 }
 
@@ -240,6 +339,75 @@ inline bool operator==(const ExecutePacket& lhs, const ExecutePacket& rhs) {
            lhs.valid == rhs.valid;
 }
 
+// Stream insertion operator for FetchBundle
+inline std::ostream& operator<<(std::ostream& os, const FetchBundle& bundle) {
+    os << "FetchBundle{count=" << static_cast<int>(bundle.count);
+    for (uint8_t i = 0; i < bundle.count; i++) {
+        os << ", " << bundle.packets[i];
+    }
+    os << "}";
+    return os;
+}
+
+// Equality comparison operator for FetchBundle (only occupied slots are compared)
+inline bool operator==(const FetchBundle& lhs, const FetchBundle& rhs) {
+    if (lhs.count != rhs.count) {
+        return false;
+    }
+    for (uint8_t i = 0; i < lhs.count; i++) {
+        if (!(lhs.packets[i] == rhs.packets[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Stream insertion operator for DecodeBundle
+inline std::ostream& operator<<(std::ostream& os, const DecodeBundle& bundle) {
+    os << "DecodeBundle{count=" << static_cast<int>(bundle.count);
+    for (uint8_t i = 0; i < bundle.count; i++) {
+        os << ", " << bundle.packets[i];
+    }
+    os << "}";
+    return os;
+}
+
+// Equality comparison operator for DecodeBundle (only occupied slots are compared)
+inline bool operator==(const DecodeBundle& lhs, const DecodeBundle& rhs) {
+    if (lhs.count != rhs.count) {
+        return false;
+    }
+    for (uint8_t i = 0; i < lhs.count; i++) {
+        if (!(lhs.packets[i] == rhs.packets[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Stream insertion operator for ExecuteBundle
+inline std::ostream& operator<<(std::ostream& os, const ExecuteBundle& bundle) {
+    os << "ExecuteBundle{count=" << static_cast<int>(bundle.count);
+    for (uint8_t i = 0; i < bundle.count; i++) {
+        os << ", " << bundle.packets[i];
+    }
+    os << "}";
+    return os;
+}
+
+// Equality comparison operator for ExecuteBundle (only occupied slots are compared)
+inline bool operator==(const ExecuteBundle& lhs, const ExecuteBundle& rhs) {
+    if (lhs.count != rhs.count) {
+        return false;
+    }
+    for (uint8_t i = 0; i < lhs.count; i++) {
+        if (!(lhs.packets[i] == rhs.packets[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // Add inequality operators (not equal)
 inline bool operator!=(const FetchPacket& lhs, const FetchPacket& rhs) {
     return !(lhs == rhs);
@@ -253,15 +421,28 @@ inline bool operator!=(const ExecutePacket& lhs, const ExecutePacket& rhs) {
     return !(lhs == rhs);
 }
 
+inline bool operator!=(const FetchBundle& lhs, const FetchBundle& rhs) {
+    return !(lhs == rhs);
+}
+
+inline bool operator!=(const DecodeBundle& lhs, const DecodeBundle& rhs) {
+    return !(lhs == rhs);
+}
+
+inline bool operator!=(const ExecuteBundle& lhs, const ExecuteBundle& rhs) {
+    return !(lhs == rhs);
+}
+
 // SystemC trace functions for packet types
 namespace sc_core {
     // Trace function for FetchPacket
     inline void sc_trace(sc_trace_file* tf, const FetchPacket& packet, const std::string& name) {
         sc_trace(tf, packet.instruction, name + ".instruction");
         sc_trace(tf, packet.pc, name + ".pc");
+        sc_trace(tf, packet.predicted_pc, name + ".predicted_pc");
         sc_trace(tf, packet.valid, name + ".valid");
     }
-
+    
     // Trace function for DecodePacket
     inline void sc_trace(sc_trace_file* tf, const DecodePacket& packet, const std::string& name) {
         sc_trace(tf, packet.instruction, name + ".instruction");
@@ -274,9 +455,13 @@ namespace sc_core {
         sc_trace(tf, packet.rs2, name + ".rs2");
         sc_trace(tf, packet.rd, name + ".rd");
         sc_trace(tf, packet.imm, name + ".imm");
+        sc_trace(tf, packet.length, name + ".length");
+        sc_trace(tf, packet.predicted_pc, name + ".predicted_pc");
+        sc_trace(tf, static_cast<int>(packet.fusion), name + ".fusion");
+        sc_trace(tf, packet.imm2, name + ".imm2");
         sc_trace(tf, packet.valid, name + ".valid");
     }
-
+    
     // Trace function for ExecutePacket
     inline void sc_trace(sc_trace_file* tf, const ExecutePacket& packet, const std::string& name) {
         sc_trace(tf, packet.instruction, name + ".instruction");
@@ -291,6 +476,30 @@ namespace sc_core {
         sc_trace(tf, packet.branch_target, name + ".branch_target");
         sc_trace(tf, packet.valid, name + ".valid");
     }
+    
+    // Trace function for FetchBundle
+    inline void sc_trace(sc_trace_file* tf, const FetchBundle& bundle, const std::string& name) {
+        sc_trace(tf, bundle.count, name + ".count");
+        for (unsigned int i = 0; i < MAX_PIPELINE_WIDTH; i++) {
+            sc_trace(tf, bundle.packets[i], name + ".packets_" + std::to_string(i));
+        }
+    }
+    
+    // Trace function for DecodeBundle
+    inline void sc_trace(sc_trace_file* tf, const DecodeBundle& bundle, const std::string& name) {
+        sc_trace(tf, bundle.count, name + ".count");
+        for (unsigned int i = 0; i < MAX_PIPELINE_WIDTH; i++) {
+            sc_trace(tf, bundle.packets[i], name + ".packets_" + std::to_string(i));
+        }
+    }
+    
+    // Trace function for ExecuteBundle
+    inline void sc_trace(sc_trace_file* tf, const ExecuteBundle& bundle, const std::string& name) {
+        sc_trace(tf, bundle.count, name + ".count");
+        for (unsigned int i = 0; i < MAX_PIPELINE_WIDTH; i++) {
+            sc_trace(tf, bundle.packets[i], name + ".packets_" + std::to_string(i));
+        }
+    }
 }
 
 #endif // TYPES_H
@@ -0,0 +1,30 @@
+#ifndef COMPRESSED_H
+#define COMPRESSED_H
+
+#include "common/types.h"
+
+// RVC (C extension) support shared by fetch predecode and decode.
+// Instructions whose low two bits are not 11 are 16 bits long.
+
+inline bool is_compressed(Instruction inst) {
+    return (inst & 0x3) != 0x3;
+}
+
+// Instruction size in bytes (2 or 4)
+inline unsigned int instruction_length(Instruction inst) {
+    return is_compressed(inst) ? 2 : 4;
+}
+
+// Expand a 16-bit encoding to its 32-bit equivalent. xlen (32 or 64)
+// selects between encodings the two base ISAs assign differently, such as
+// C.JAL and C.ADDIW. Reserved and floating-point encodings expand to 0,
+// which decodes as an unknown opcode.
+Instruction expand_compressed(uint16_t inst, unsigned int xlen);
+
+// The 32-bit form of any instruction: compressed encodings are expanded,
+// full-size ones are returned unchanged
+inline Instruction expand_instruction(Instruction inst, unsigned int xlen) {
+    return is_compressed(inst) ? expand_compressed(static_cast<uint16_t>(inst), xlen) : inst;
+}
+
+#endif // COMPRESSED_H
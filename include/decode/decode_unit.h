@@ -3,27 +3,41 @@
 
 #include <systemc.h>
 #include "common/types.h"
+#include "fetch/uop_cache.h"
 
 class DecodeUnit : public sc_module {
 public:
     // Ports
     sc_in<bool> clk;
     sc_in<bool> reset;
-    sc_in<FetchPacket> fetch_in;
-    sc_out<DecodePacket> decode_out;
+    sc_in<FetchBundle> fetch_in;
+    sc_out<DecodeBundle> decode_out;
     
     // Control signals
     sc_in<bool> stall;
+    sc_in<bool> flush;    // Misprediction redirect: drop the wrong-path input
     
     // Constructor
     SC_HAS_PROCESS(DecodeUnit);
-    DecodeUnit(sc_module_name name);
+    DecodeUnit(sc_module_name name, bool fusion = false);
+    
+    // Base ISA width (32 or 64), which selects the RVC encodings to expand
+    void set_xlen(unsigned int bits) { xlen = bits; }
+    
+    // Micro-op cache filled with each decoded block (not owned)
+    void set_uop_cache(UopCache* cache) { uop_cache = cache; }
     
 private:
+    unsigned int xlen;
+    bool fusion_enabled;   // Fuse adjacent instruction pairs into one op
+    UopCache* uop_cache;
+    
     // Process methods
     void decode_proc();
     
     // Helper methods
+    DecodePacket decode_instruction(const FetchPacket& fetch_packet);
+    bool fuse(const DecodePacket& first, const DecodePacket& second, DecodePacket& fused);
     InstructionType get_instruction_type(Instruction inst);
     Opcode get_opcode(Instruction inst);
     Funct3 get_funct3(Instruction inst);
@@ -3,33 +3,72 @@
 
 #include <systemc.h>
 #include <vector>
+#include <deque>
 #include "common/types.h"
+#include "common/config.h"
+#include "common/performance_analyzer.h"
 #include "memory/memory_system.h"
 
 // Forward declarations
 class ReservationStation;
 class ReorderBuffer;
 class RegisterFile;
+class RenameUnit;
+class FunctionalUnitPool;
+class LoadStoreQueue;
+class StoreSetPredictor;
+class LoadValuePredictor;
+class StoreBuffer;
 
 class ExecutionUnit : public sc_module {
 public:
     // Ports
     sc_in<bool> clk;
     sc_in<bool> reset;
-    sc_in<DecodePacket> decode_in;
-    sc_out<ExecutePacket> execute_out;
+    sc_in<DecodeBundle> decode_in;
+    sc_in<DecodeBundle> uop_in;       // Blocks from the micro-op cache, younger than decode_in
+    sc_out<ExecuteBundle> execute_out;    // Branches resolved this cycle, for the predictor
+    
+    // Backpressure to the front end when the instruction queue fills up
+    sc_out<bool> stall_out;
+    
+    // Fetch redirect after a mispredicted control instruction
+    sc_out<bool> redirect_out;
+    sc_out<Address> redirect_target;
     
     // Interface to memory system
     sc_port<memory_if> mem_interface;
     
     // Constructor
     SC_HAS_PROCESS(ExecutionUnit);
-    ExecutionUnit(sc_module_name name);
+    ExecutionUnit(sc_module_name name, const ProcessorConfig& config = ProcessorConfig());
     
     // Destructor
     ~ExecutionUnit();
     
+    // Attach the analyzer that receives dispatch statistics
+    void set_performance_analyzer(PerformanceAnalyzer* analyzer) { perf = analyzer; }
+    
+    // Number of instructions committed so far
+    uint64_t get_retired_count() const { return retired_count; }
+    
 private:
+    // Configuration
+    unsigned int dispatch_width;
+    unsigned int bundle_width;        // Largest group that can arrive in one cycle
+    unsigned int instruction_queue_size;
+    unsigned int commit_width;
+    RenameMode rename_mode;
+    SelectPolicy select_policy;
+    MemDepPolicy mem_dep_policy;
+    bool eliminate_at_rename;
+    
+    // Cycles the store buffer's write port spends on a data cache lookup
+    unsigned int dcache_latency;
+    
+    // Performance analyzer (not owned)
+    PerformanceAnalyzer* perf;
+    
     // Components
     ReservationStation* rs_alu;
     ReservationStation* rs_mem;
@@ -37,9 +76,41 @@ private:
     ReorderBuffer* rob;
     RegisterFile* regfile;
     
+    // Merged rename mode: alias table and physical register file
+    RenameUnit* rename;
+    RegisterFile* prf;
+    
+    // Functional units between issue and result broadcast
+    FunctionalUnitPool* fu_pool;
+    
+    // Loads and stores in program order
+    LoadStoreQueue* lsq;
+    
+    // Memory dependence predictor (store-set policy)
+    StoreSetPredictor* store_sets;
+    
+    // Load value predictor (null when value prediction is off)
+    LoadValuePredictor* value_predictor;
+    
+    // Retired stores waiting to be written to memory
+    StoreBuffer* store_buffer;
+    
     // Register status table
     std::vector<RegisterStatus> reg_status;
     
+    // Decoded instructions waiting for dispatch, oldest first
+    std::deque<DecodePacket> instruction_queue;
+    
+    // Resolved branches not yet reported to the predictor (more than a
+    // bundle's worth can finish in one cycle when latencies differ)
+    std::deque<ExecutePacket> resolved_branches;
+    
+    // Fetch was redirected by a squash and nothing has been dispatched since
+    bool refilling;
+    
+    // Statistics
+    uint64_t retired_count;
+    
     // Process methods
     void issue_proc();
     void execute_proc();
@@ -47,8 +118,23 @@ private:
     void commit_proc();
     
     // Helper methods
+    bool dispatch_instruction(const DecodePacket& decode_packet, DispatchStall& reason);
+    RetireStall classify_head_stall() const;
+    SlotLoss classify_backend_stall(DispatchStall reason) const;
+    void issue_ready(ReservationStation* rs);
+    void order_ready(std::vector<std::pair<RSEntry, int>>& ready) const;
+    int result_tag(int rob_index) const;
+    void complete_at_rename(int rob_index, RegisterValue value);
+    void resolve_moves(int tag, RegisterValue value);
+    void read_operand(uint8_t reg, RegisterValue& value, uint16_t& tag);
+    RegisterValue read_memory(Address addr, uint8_t size);
+    void drain_store_buffer();
+    void report_resolved_branches();
+    void resolve_branch(int rob_index, const RSEntry& entry, const ExecutePacket& result);
+    void validate_value_prediction(int rob_index, const RSEntry& entry, RegisterValue value);
+    void recover(int rob_index, Address target);
     void execute_alu_op(RSEntry& entry, ExecutePacket& result);
-    void execute_mem_op(RSEntry& entry, ExecutePacket& result);
+    bool execute_mem_op(RSEntry& entry, int rob_index, ExecutePacket& result, unsigned int& mem_latency);
     void execute_branch_op(RSEntry& entry, ExecutePacket& result);
 };
 
@@ -0,0 +1,93 @@
+#ifndef FUNCTIONAL_UNIT_H
+#define FUNCTIONAL_UNIT_H
+
+#include <systemc.h>
+#include <vector>
+#include <map>
+#include "common/types.h"
+#include "common/config.h"
+
+// An operation travelling through a functional unit
+struct FUOperation {
+    int rob_index;
+    RSEntry entry;
+    ExecutePacket result;
+    FUType type;
+    unsigned int unit;       // Index of the unit within its class
+    uint64_t unit_busy_until;  // Last cycle the operation occupies its unit
+    uint64_t finish_cycle;   // Cycle in which the result is broadcast
+};
+
+// Pools of ALUs, AGUs, branch units, multipliers and dividers with
+// per-opcode latencies. Pipelined units accept one operation per cycle;
+// unpipelined units are busy until their operation finishes.
+class FunctionalUnitPool : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(FunctionalUnitPool);
+    FunctionalUnitPool(sc_module_name name, const ProcessorConfig& config);
+    
+    // Drop all in-flight operations and free every unit
+    void reset();
+    
+    // Advance to the next cycle
+    void tick() { cycle++; }
+    
+    // Unit class that executes an instruction
+    static FUType unit_for(const RSEntry& entry);
+    
+    // Cycles from issue to result for an opcode
+    unsigned int latency(Opcode opcode) const;
+    
+    // Cycles from issue to result for an instruction, including the
+    // operand-dependent latency of a divide
+    unsigned int latency(const RSEntry& entry) const;
+    
+    // Override the latency of an opcode
+    void set_latency(Opcode opcode, unsigned int cycles);
+    
+    // Check if a unit of the given class can accept an operation this cycle
+    bool can_issue(FUType type) const;
+    
+    // Start an operation on a free unit; returns false if none is free.
+    // extra_latency covers time spent outside the unit, e.g. a cache access.
+    bool issue(int rob_index, const RSEntry& entry, const ExecutePacket& result,
+               unsigned int extra_latency = 0);
+    
+    // Remove and return operations whose results are due this cycle
+    std::vector<FUOperation> collect_finished();
+    
+    // Discard the in-flight operation of a squashed ROB entry
+    void squash(int rob_index);
+    
+    // Number of units of a class and how many accepted an operation this cycle
+    unsigned int unit_count(FUType type) const;
+    unsigned int issued_this_cycle(FUType type) const;
+    
+private:
+    // Per-class configuration
+    std::map<FUType, FunctionalUnitConfig> unit_config;
+    
+    // Cycle up to which each unit is occupied
+    std::map<FUType, std::vector<uint64_t>> busy_until;
+    
+    // Operations issued in the current cycle, per class
+    std::map<FUType, unsigned int> issued;
+    
+    // Per-opcode latency table
+    std::map<Opcode, unsigned int> op_latency;
+    
+    // Operations in flight
+    std::vector<FUOperation> in_flight;
+    
+    uint64_t cycle;
+    uint64_t issued_cycle;   // Cycle the issued counters refer to
+    
+    // Unit class for the opcodes that do not depend on funct7
+    static FUType unit_for(Opcode opcode);
+    
+    // Iterative divider latency for the operands of a DIV/REM instruction
+    unsigned int divide_latency(const RSEntry& entry) const;
+};
+
+#endif // FUNCTIONAL_UNIT_H
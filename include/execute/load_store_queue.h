@@ -0,0 +1,103 @@
+#ifndef LOAD_STORE_QUEUE_H
+#define LOAD_STORE_QUEUE_H
+
+#include <systemc.h>
+#include <deque>
+#include "common/types.h"
+
+// Outcome of searching older stores for a load's data
+enum class LoadForward {
+    NONE,       // No older store with a known overlapping address; read memory
+    FORWARDED,  // An older store covers the load; data taken from it
+    BLOCKED     // An older store partially overlaps; wait for it to commit
+};
+
+// Load queue entry
+struct LoadQueueEntry {
+    uint64_t seq;            // Program order among memory operations
+    int rob_index;
+    bool executed;
+    Address addr;
+    uint8_t size;
+    uint64_t source_seq;     // Store the data was forwarded from (0 = memory)
+    uint64_t wait_seq;       // Store predicted to alias this load (0 = none)
+};
+
+// Store queue entry
+struct StoreQueueEntry {
+    uint64_t seq;            // Program order among memory operations
+    int rob_index;
+    bool resolved;           // Address and data known
+    Address addr;
+    uint8_t size;
+    RegisterValue data;
+    uint64_t wait_seq;       // Earlier store of the same store set (0 = none)
+};
+
+// Load and store queues. Loads may execute ahead of older stores whose
+// address is still unknown; when such a store resolves, any younger load
+// that read an overlapping location from an older source is reported so
+// the pipeline can replay it.
+class LoadStoreQueue : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(LoadStoreQueue);
+    LoadStoreQueue(sc_module_name name, int load_entries, int store_entries);
+    
+    // Reset both queues
+    void reset();
+    
+    // Check if a queue is full
+    bool is_load_queue_full() const;
+    bool is_store_queue_full() const;
+    
+    // Allocate entries in program order at dispatch, optionally waiting for
+    // a predicted aliasing store; returns the entry's sequence number
+    uint64_t allocate_load(int rob_index, uint64_t wait_seq = 0);
+    uint64_t allocate_store(int rob_index, uint64_t wait_seq = 0);
+    
+    // Check if a memory operation may execute: its predicted store must have
+    // resolved, and in conservative mode a load also waits for every older
+    // store address
+    bool may_issue(int rob_index, bool conservative) const;
+    
+    // Sequence number of an in-flight memory operation (0 if not found)
+    uint64_t sequence_of(int rob_index) const;
+    
+    // Search older stores for the load's data; source_seq names the store forwarded from
+    LoadForward forward_load(int rob_index, Address addr, uint8_t size,
+                             RegisterValue& data, uint64_t& source_seq) const;
+    
+    // Record that a load read its data (from source_seq, or memory if 0)
+    void load_executed(int rob_index, Address addr, uint8_t size, uint64_t source_seq);
+    
+    // Record a store's address and data; returns the ROB index of the oldest
+    // younger load that already read stale data, or -1
+    int resolve_store(int rob_index, Address addr, uint8_t size, RegisterValue data);
+    
+    // Remove the oldest load/store when it commits
+    void commit_load(int rob_index);
+    void commit_store(int rob_index);
+    
+    // Remove the entry of a squashed instruction
+    void squash(int rob_index);
+    
+private:
+    int max_loads;
+    int max_stores;
+    
+    // Entries, oldest first
+    std::deque<LoadQueueEntry> load_queue;
+    std::deque<StoreQueueEntry> store_queue;
+    
+    // Next sequence number (0 is reserved for "memory")
+    uint64_t next_seq;
+    
+    // Check if a store is still in the queue without an address
+    bool is_store_pending(uint64_t seq) const;
+    
+    // Check if two byte ranges overlap
+    static bool overlaps(Address a, uint8_t a_size, Address b, uint8_t b_size);
+};
+
+#endif // LOAD_STORE_QUEUE_H
@@ -0,0 +1,55 @@
+#ifndef LOAD_VALUE_PREDICTOR_H
+#define LOAD_VALUE_PREDICTOR_H
+
+#include <systemc.h>
+#include <vector>
+#include "common/types.h"
+
+// Last-value/stride load value predictor. Each load PC remembers the value
+// it last retired with and the stride between its last two values; once the
+// stride has repeated often enough, dispatch hands consumers the next value
+// in the sequence before the load has read memory.
+class LoadValuePredictor : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(LoadValuePredictor);
+    LoadValuePredictor(sc_module_name name, unsigned int entries = 1024,
+                       unsigned int confidence_threshold = 7);
+    
+    // Forget all learned values
+    void reset();
+    
+    // A load was dispatched; returns true with its predicted value if the
+    // entry is confident. Earlier instances still in flight are counted so
+    // the prediction skips ahead by one stride per instance.
+    bool predict(Address pc, RegisterValue& value);
+    
+    // A load retired with its actual value
+    void train(Address pc, RegisterValue value);
+    
+    // A dispatched load was squashed before retiring
+    void squash(Address pc);
+    
+    // A prediction turned out wrong; stop predicting until the stride repeats again
+    void mispredicted(Address pc);
+    
+private:
+    static const unsigned int MAX_CONFIDENCE = 7;    // 3-bit saturating counter
+    
+    struct Entry {
+        bool valid;
+        Address tag;               // Full PC of the load owning the entry
+        RegisterValue last_value;  // Value of the youngest retired instance
+        int64_t stride;            // Difference between the last two retired values
+        unsigned int confidence;   // Consecutive retirements matching the stride
+        unsigned int inflight;     // Dispatched instances not yet retired or squashed
+    };
+    
+    unsigned int num_entries;
+    unsigned int threshold;
+    std::vector<Entry> table;
+    
+    Entry* find(Address pc);
+};
+
+#endif // LOAD_VALUE_PREDICTOR_H
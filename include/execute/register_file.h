@@ -20,6 +20,9 @@ public:
     // Write a value to a register
     void write(int index, RegisterValue value);
     
+    // Number of registers
+    int size() const { return static_cast<int>(registers.size()); }
+    
 private:
     // Register values
     std::vector<RegisterValue> registers;
@@ -0,0 +1,72 @@
+#ifndef RENAME_UNIT_H
+#define RENAME_UNIT_H
+
+#include <systemc.h>
+#include <vector>
+#include <deque>
+#include "common/types.h"
+
+// Register alias table, free list and checkpoints for merged-register-file
+// renaming. Physical register 0 is permanently mapped to x0.
+class RenameUnit : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(RenameUnit);
+    RenameUnit(sc_module_name name, int arch_regs, int phys_regs, int checkpoints);
+    
+    // Reset to the identity mapping with all other registers free
+    void reset();
+    
+    // Physical register currently mapped to an architectural register
+    int lookup(int arch_reg) const;
+    
+    // Check if a physical register can be allocated
+    bool has_free_register() const;
+    
+    // Number of physical registers not on the free list
+    int allocated_count() const;
+    
+    // Map arch_reg to a fresh physical register, returning it and the previous mapping
+    int allocate(int arch_reg, int& old_phys_reg);
+    
+    // Point an architectural register back at an older physical register
+    void restore_mapping(int arch_reg, int phys_reg);
+    
+    // Return a physical register to the free list
+    void release(int phys_reg);
+    
+    // Ready scoreboard for physical registers
+    bool is_ready(int phys_reg) const;
+    void set_ready(int phys_reg);
+    
+    // Check if a checkpoint slot is free
+    bool has_free_checkpoint() const;
+    
+    // Snapshot the alias table, returns the checkpoint id or -1 if none free
+    int take_checkpoint();
+    
+    // Restore the alias table from a checkpoint (the checkpoint stays allocated)
+    void restore_checkpoint(int id);
+    
+    // Free a checkpoint slot
+    void release_checkpoint(int id);
+    
+private:
+    int num_arch_regs;
+    int num_phys_regs;
+    
+    // Speculative alias table: architectural -> physical
+    std::vector<int> rat;
+    
+    // Free physical registers, allocated from the front
+    std::deque<int> free_list;
+    
+    // Physical register holds its final value
+    std::vector<bool> ready;
+    
+    // Saved alias tables and whether each slot is in use
+    std::vector<std::vector<int>> checkpoints;
+    std::vector<bool> checkpoint_used;
+};
+
+#endif // RENAME_UNIT_H
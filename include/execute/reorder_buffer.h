@@ -56,6 +56,24 @@ public:
     // Get newly completed entries (for forwarding)
     std::vector<std::pair<int, RegisterValue>> get_newly_completed();
     
+    // Get a copy of any entry
+    ROBEntry get_entry(int index) const;
+    
+    // Check if an index currently holds an in-flight instruction
+    bool is_entry_busy(int index) const;
+    
+    // Index following an entry in program order
+    int next_index(int index) const;
+    
+    // Index preceding an entry in program order
+    int prev_index(int index) const;
+    
+    // Distance of an entry from the head (0 = oldest)
+    int get_position(int index) const;
+    
+    // Discard every entry younger than index; returns their indices, youngest first
+    std::vector<int> squash_after(int index);
+    
 private:
     // Maximum number of entries
     int max_entries;
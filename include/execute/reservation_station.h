@@ -26,6 +26,9 @@ public:
     // Get entries that are ready to execute
     std::vector<std::pair<RSEntry, int>> get_ready_entries();
     
+    // Count entries still waiting for the result with the given tag
+    int count_waiting(int tag) const;
+    
     // Update waiting entries when a result becomes available
     void update_waiting_entries(int tag, RegisterValue value);
     
@@ -0,0 +1,66 @@
+#ifndef STORE_BUFFER_H
+#define STORE_BUFFER_H
+
+#include <systemc.h>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include "common/types.h"
+
+// One cache line worth of committed store data
+struct StoreBufferLine {
+    Address line_addr;               // Line-aligned address
+    std::vector<uint8_t> data;       // Line bytes
+    std::vector<bool> valid;         // Bytes written by buffered stores
+};
+
+// Post-commit store buffer. Retired stores are combined per cache line and
+// written to the data cache in order at a bounded rate; loads see buffered
+// bytes ahead of memory.
+class StoreBuffer : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(StoreBuffer);
+    StoreBuffer(sc_module_name name, int lines, int line_size, unsigned int drain_interval);
+    
+    // Drop all buffered stores
+    void reset();
+    
+    // Check if a store can be accepted (a free line or one to combine into)
+    bool can_accept(Address addr, uint8_t size) const;
+    
+    // Add a committed store; returns true if it combined into a buffered line
+    bool insert(Address addr, RegisterValue data, uint8_t size);
+    
+    // Address of the oldest buffered line; false if the buffer is empty
+    bool peek(Address& line_addr) const;
+    
+    // Remove the oldest line if the write port is free this cycle
+    bool drain(StoreBufferLine& line);
+    
+    // Keep the write port busy for at least the given number of cycles
+    void hold(unsigned int cycles) { drain_wait = std::max(drain_wait, cycles); }
+    
+    // Overlay buffered bytes onto data read from memory
+    RegisterValue forward(Address addr, uint8_t size, RegisterValue memory_data) const;
+    
+    // Number of buffered lines
+    int occupancy() const { return static_cast<int>(lines.size()); }
+    
+private:
+    int max_lines;
+    int line_bytes;
+    unsigned int drain_cycles;
+    
+    // Cycles until the write port can accept the next line
+    unsigned int drain_wait;
+    
+    // Buffered lines, oldest first
+    std::deque<StoreBufferLine> lines;
+    
+    Address line_of(Address addr) const { return addr - (addr % line_bytes); }
+    StoreBufferLine* find_line(Address line_addr);
+    const StoreBufferLine* find_line(Address line_addr) const;
+};
+
+#endif // STORE_BUFFER_H
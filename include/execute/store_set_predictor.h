@@ -0,0 +1,58 @@
+#ifndef STORE_SET_PREDICTOR_H
+#define STORE_SET_PREDICTOR_H
+
+#include <systemc.h>
+#include <vector>
+#include "common/types.h"
+
+// Store-set memory dependence predictor. The store set ID table (SSIT)
+// maps load and store PCs to a store set; the last fetched store table
+// (LFST) holds the most recently dispatched, not yet resolved store of each
+// set. A load waits for that store instead of speculating past it.
+class StoreSetPredictor : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(StoreSetPredictor);
+    StoreSetPredictor(sc_module_name name, unsigned int ssit_size = 1024,
+                      unsigned int lfst_size = 128, uint64_t clear_interval = 100000);
+    
+    // Forget all learned dependences
+    void reset();
+    
+    // Advance one cycle, periodically clearing the tables so stale sets
+    // do not serialize unrelated accesses forever
+    void tick();
+    
+    // Store the instruction at pc should wait for (sequence number, 0 if none)
+    uint64_t predict(Address pc) const;
+    
+    // A store was dispatched; it becomes the last store of its set
+    void store_dispatched(Address pc, uint64_t seq);
+    
+    // A store's address is known; later members of its set may proceed
+    void store_resolved(Address pc, uint64_t seq);
+    
+    // A load read stale data ahead of a store; put both in the same set
+    void record_violation(Address load_pc, Address store_pc);
+    
+private:
+    static const unsigned int INVALID_SET = ~0u;
+    
+    unsigned int ssit_entries;
+    unsigned int lfst_entries;
+    uint64_t clear_cycles;
+    uint64_t cycle;
+    
+    // Store set ID per PC index
+    std::vector<unsigned int> ssit;
+    
+    // Last dispatched store per set (0 = none)
+    std::vector<uint64_t> lfst;
+    
+    // Next store set ID to hand out
+    unsigned int next_set;
+    
+    unsigned int ssit_index(Address pc) const;
+};
+
+#endif // STORE_SET_PREDICTOR_H
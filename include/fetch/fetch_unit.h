@@ -2,16 +2,37 @@
 #define FETCH_UNIT_H
 
 #include <systemc.h>
+#include <deque>
 #include "common/types.h"
 #include "memory/memory_system.h"
 #include "fetch/branch_predictor.h"
+#include "fetch/uop_cache.h"
 
+class PerformanceAnalyzer;
+
+// A predicted fetch block: sequential instructions within one cache line,
+// ending at a predicted-taken control transfer or the line boundary. With
+// compressed instructions the last one may straddle into the next line.
+struct FetchBlock {
+    Address start_pc;
+    Address end_pc;          // First byte after the block's last instruction
+    unsigned int count;      // Instructions in the block
+    Address next_pc;         // Predicted address after the block
+    bool prefetched;         // Instruction prefetch already requested
+};
+
+// Decoupled front end: the branch predictor runs ahead of fetch and queues
+// fetch blocks in the fetch target queue (FTQ). Queued blocks drive
+// instruction cache prefetches so misses overlap with earlier fetches.
 class FetchUnit : public sc_module {
 public:
     // Ports
     sc_in<bool> clk;
     sc_in<bool> reset;
-    sc_out<FetchPacket> fetch_out;
+    sc_out<FetchBundle> fetch_out;
+    
+    // Decoded blocks from the micro-op cache, straight to dispatch
+    sc_out<DecodeBundle> uop_out;
     
     // Interface to memory system
     sc_port<memory_if> mem_interface;
@@ -25,11 +46,26 @@ public:
     
     // Constructor
     SC_HAS_PROCESS(FetchUnit);
-    FetchUnit(sc_module_name name, PredictorType predictor_type = PredictorType::TWO_BIT);
+    FetchUnit(sc_module_name name, PredictorType predictor_type = PredictorType::TWO_BIT,
+              unsigned int width = 1, unsigned int line_size = 64,
+              unsigned int ftq_entries = 8);
     
     // Destructor
     ~FetchUnit();
     
+    // Set performance analyzer
+    void set_performance_analyzer(PerformanceAnalyzer* analyzer) { perf = analyzer; }
+    
+    // Set the address fetch starts from after reset
+    void set_reset_pc(Address addr) { reset_pc = addr; }
+    
+    // Base ISA width (32 or 64), which selects the RVC encodings predecode sees
+    void set_xlen(unsigned int bits) { xlen = bits; }
+    
+    // Attach a micro-op cache (not owned), its delivery width and the
+    // cycles lost switching between it and the decoders
+    void set_uop_cache(UopCache* cache, unsigned int width, unsigned int switch_penalty);
+    
     // Update branch predictor with actual outcome
     void update_branch_prediction(Address pc, bool taken);
     
@@ -40,15 +76,45 @@ public:
     
 private:
     // Internal state
-    Address pc;
+    Address pc;                    // Start of the next block the predictor generates
+    Address reset_pc;              // Program entry point
+    unsigned int fetch_width;      // Instructions fetched per cycle
+    unsigned int xlen;
+    
+    // Fetch target queue, oldest block first
+    std::deque<FetchBlock> ftq;
+    unsigned int ftq_size;
+    
+    // Instruction cache state
+    unsigned int icache_line_size;
+    Address current_line;          // Line the last fetch looked up
+    bool current_line_valid;
+    Address spanned_line;          // Line before current_line when the last lookup
+    bool spanned_line_valid;       // read both for a straddling instruction
+    unsigned int icache_wait;      // Cycles left on an instruction cache miss
+    
+    // Micro-op cache state
+    UopCache* uop_cache;           // nullptr when there is none
+    unsigned int uop_width;
+    unsigned int uop_switch_penalty;
+    bool uop_active;               // Last delivery came from the micro-op cache
+    unsigned int switch_wait;      // Cycles left on a path switch
     
     // Branch predictor
     BranchPredictor* branch_predictor;
     
+    // Performance analyzer (not owned)
+    PerformanceAnalyzer* perf;
+    
     // Process methods
     void fetch_proc();
     
     // Helper methods
+    void predict_block();
+    void prefetch_blocks();
+    void fetch_group(FetchBundle& bundle);
+    bool fetch_uops(DecodeBundle& bundle);
+    Address line_of(Address addr) const { return addr - (addr % icache_line_size); }
     Address predict_next_pc(Address current_pc, Instruction inst);
 };
 
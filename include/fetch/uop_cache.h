@@ -0,0 +1,52 @@
+#ifndef UOP_CACHE_H
+#define UOP_CACHE_H
+
+#include <systemc.h>
+#include <vector>
+#include "common/types.h"
+#include "common/config.h"
+
+// The decoded packets of one fetch block
+struct UopCacheEntry {
+    bool valid;
+    Address start_pc;        // First byte of the block
+    Address end_pc;          // First byte after the block
+    uint8_t count;           // Packets held (fused pairs count once)
+    DecodePacket packets[MAX_PIPELINE_WIDTH];
+    uint64_t last_use;       // For LRU replacement
+};
+
+// Set-associative micro-op cache indexed by fetch block start address.
+// Decode fills it with the packets it produces for each block; fetch looks
+// up queued blocks and, on a hit, hands the packets straight to dispatch.
+// A block only hits if it ends where the cached one did, so a change in
+// the predicted exit of a block is a miss.
+class UopCache : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(UopCache);
+    UopCache(sc_module_name name, const UopCacheConfig& config);
+    
+    // Invalidate every entry
+    void reset();
+    
+    // Entry for the block [start_pc, end_pc) (updating LRU), or nullptr on a miss
+    const UopCacheEntry* lookup(Address start_pc, Address end_pc);
+    
+    // Install a decoded block, replacing any entry for the same start
+    // address or else the set's LRU entry
+    void insert(Address start_pc, Address end_pc, const DecodeBundle& bundle);
+    
+private:
+    unsigned int num_sets;
+    unsigned int num_ways;
+    uint64_t use_counter;
+    
+    // num_sets * num_ways entries, set-major
+    std::vector<UopCacheEntry> entries;
+    
+    // First way of the set a block maps to, indexed by its 16-byte window
+    UopCacheEntry* set_of(Address start_pc) { return &entries[((start_pc >> 4) % num_sets) * num_ways]; }
+};
+
+#endif // UOP_CACHE_H
@@ -0,0 +1,84 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <systemc.h>
+#include <vector>
+#include "common/types.h"
+#include "common/config.h"
+
+// Line displaced by a fill
+struct CacheEviction {
+    bool valid;          // A valid line was replaced
+    bool dirty;          // It must be written back
+    bool unused_prefetch;// It was prefetched and never referenced
+    Address line_addr;   // Its line address
+};
+
+// Set-associative cache timing model. Only tags and replacement state are
+// kept; data always comes from the backing store.
+class Cache : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(Cache);
+    Cache(sc_module_name name, const CacheConfig& config);
+    
+    // Invalidate every line
+    void reset();
+    
+    // Look up the line holding addr, allocating it on a miss (write-allocate).
+    // Returns true on a hit; eviction reports the victim of a fill.
+    bool access(Address addr, bool is_write, CacheEviction& eviction);
+    
+    // Check if the line holding addr is present without touching replacement state
+    bool probe(Address addr) const;
+    
+    // Install the line holding addr on behalf of a prefetcher (no-op if present)
+    void fill(Address addr, CacheEviction& eviction);
+    
+    // First demand use of a prefetched line: clears the mark and returns true
+    bool consume_prefetch(Address addr);
+    
+    // Configuration
+    unsigned int get_hit_latency() const { return hit_latency; }
+    Address line_address(Address addr) const { return addr - (addr % line_size); }
+    
+private:
+    struct CacheLine {
+        bool valid;
+        bool dirty;
+        bool prefetched;     // Brought in by a prefetch, not yet referenced
+        Address tag;
+        uint64_t last_use;   // LRU timestamp
+        uint8_t rrpv;        // RRIP re-reference prediction value
+    };
+    
+    unsigned int num_sets;
+    unsigned int num_ways;
+    unsigned int line_size;
+    unsigned int hit_latency;
+    ReplacementPolicy policy;
+    
+    // Lines indexed by set * num_ways + way
+    std::vector<CacheLine> lines;
+    
+    // Tree pseudo-LRU bits, num_ways - 1 per set
+    std::vector<bool> plru_bits;
+    
+    // Access counter used as the LRU clock
+    uint64_t access_count;
+    
+    unsigned int set_index(Address addr) const;
+    Address tag_of(Address addr) const;
+    
+    // Replacement policy hooks
+    void touch(unsigned int set, unsigned int way, bool fill);
+    unsigned int choose_victim(unsigned int set);
+    
+    // Way holding addr in its set, or -1
+    int find_way(Address addr) const;
+    
+    // Replace a victim in the set of addr with its line
+    unsigned int allocate(Address addr, CacheEviction& eviction);
+};
+
+#endif // CACHE_H
@@ -0,0 +1,43 @@
+#ifndef DRAM_H
+#define DRAM_H
+
+#include <systemc.h>
+#include <vector>
+#include "common/types.h"
+#include "common/config.h"
+
+// Main memory timing model. Lines map to banks by row; each bank keeps its
+// last row open, so a request costs tCAS on a row buffer hit, tRCD + tCAS
+// on an idle bank and tRP + tRCD + tCAS on a conflict, plus the burst.
+// Requests to a busy bank wait for it, and requests beyond the controller
+// queue wait for the oldest one to finish.
+class Dram : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(Dram);
+    Dram(sc_module_name name, const DramConfig& config);
+    
+    // Close every row and drop queued requests
+    void reset();
+    
+    // Issue a line read or write at the given cycle and return its latency.
+    // outcome reports the row buffer state; queued is set if the request
+    // had to wait for a controller queue slot.
+    unsigned int access(Address addr, uint64_t cycle,
+                        RowBufferOutcome& outcome, bool& queued);
+                        
+private:
+    struct Bank {
+        bool row_open;
+        uint64_t open_row;
+        uint64_t busy_until;   // Cycle the bank can take the next command
+    };
+    
+    DramConfig timing;
+    std::vector<Bank> banks;
+    
+    // Completion cycles of requests held by the controller
+    std::vector<uint64_t> in_flight;
+};
+
+#endif // DRAM_H
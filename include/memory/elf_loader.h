@@ -0,0 +1,63 @@
+#ifndef ELF_LOADER_H
+#define ELF_LOADER_H
+
+#include <string>
+#include "common/types.h"
+#include "common/symbol_table.h"
+#include "memory/sparse_memory.h"
+
+// Program image on disk: a statically linked ELF32/ELF64 executable, or a
+// raw binary that is placed at address 0. The file is mapped rather than
+// read, and pages of read-only ELF segments are handed to guest memory
+// directly (copy-on-write), so loading does not copy the text.
+//
+// The core always implements RV64. An ELF32 file is accepted, but its
+// class only selects the RV32 compressed encodings; the code itself runs
+// with RV64 semantics (64-bit registers, 6-bit shift amounts, no 32-bit
+// wraparound in add or slt), so results match an RV32 core only while
+// values stay within sign-extended 32-bit range.
+class ElfLoader {
+public:
+    // Map the file; check is_open() for failure
+    ElfLoader(const std::string& filename);
+    
+    // Unmap the file (guest memory must not outlive the loader)
+    ~ElfLoader();
+    
+    bool is_open() const { return image != nullptr; }
+    bool is_elf() const { return elf_class != 0; }
+    
+    // File size in bytes
+    size_t size() const { return image_size; }
+    
+    // Place the image in guest memory and collect its symbols. Returns
+    // false if the file is a malformed ELF.
+    bool load(SparseMemory& memory, SymbolTable& symbols);
+    
+    // Entry point (0 for a raw binary)
+    Address entry() const { return entry_pc; }
+    
+    // Base ISA width from the ELF class (raw binaries are taken as RV64).
+    // Only used to pick which RVC encodings to expand.
+    unsigned int xlen() const;
+    
+    // PT_LOAD segments placed by load()
+    unsigned int segments() const { return loaded_segments; }
+    
+private:
+    uint8_t* image;
+    size_t image_size;
+    int elf_class;     // ELFCLASS32, ELFCLASS64 or 0 for a raw binary
+    Address entry_pc;
+    unsigned int loaded_segments;
+    
+    // Class-specific parsing over the Elf32_* or Elf64_* structures
+    template <typename Ehdr, typename Phdr, typename Shdr, typename Sym>
+    bool load_elf(SparseMemory& memory, SymbolTable& symbols);
+    
+    // Copy or map one segment's file contents to vaddr
+    void load_segment(SparseMemory& memory, Address vaddr, uint64_t offset,
+                      uint64_t file_size, bool writable);
+};
+
+#endif // ELF_LOADER_H
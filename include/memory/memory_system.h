@@ -4,6 +4,18 @@
 #include <systemc.h>
 #include <vector>
 #include "common/types.h"
+#include "common/config.h"
+#include "memory/cache.h"
+#include "memory/mshr.h"
+#include "memory/dram.h"
+#include "memory/prefetcher.h"
+#include "memory/tlb.h"
+#include "memory/page_table_walker.h"
+#include "memory/sparse_memory.h"
+#include "memory/elf_loader.h"
+#include "common/symbol_table.h"
+
+class PerformanceAnalyzer;
 
 // Memory interface
 class memory_if : virtual public sc_interface {
@@ -11,6 +23,17 @@ public:
     virtual Instruction read_instruction(Address addr) = 0;
     virtual RegisterValue read_data(Address addr, uint8_t size) = 0;
     virtual void write_data(Address addr, RegisterValue data, uint8_t size) = 0;
+    
+    // Timing: cycles for an instruction fetch or data access to addr.
+    // pc identifies the load or store for prefetcher training (0 if none).
+    virtual unsigned int access_instruction(Address addr) = 0;
+    virtual unsigned int access_data(Address addr, bool is_write, Address pc) = 0;
+    
+    // Check if a data access can start this cycle (a miss needs a free MSHR)
+    virtual bool can_access_data(Address addr) = 0;
+    
+    // Bring the line holding an instruction address into the instruction cache
+    virtual void prefetch_instruction(Address addr) = 0;
 };
 
 // Memory system implementation
@@ -22,22 +45,102 @@ public:
     
     // Constructor
     SC_HAS_PROCESS(MemorySystem);
-    MemorySystem(sc_module_name name);
+    MemorySystem(sc_module_name name, const ProcessorConfig& config = ProcessorConfig());
+    
+    // Destructor
+    ~MemorySystem();
     
     // Memory interface implementation
     virtual Instruction read_instruction(Address addr) override;
     virtual RegisterValue read_data(Address addr, uint8_t size) override;
     virtual void write_data(Address addr, RegisterValue data, uint8_t size) override;
+    virtual unsigned int access_instruction(Address addr) override;
+    virtual unsigned int access_data(Address addr, bool is_write, Address pc) override;
+    virtual bool can_access_data(Address addr) override;
+    virtual void prefetch_instruction(Address addr) override;
+    
+    // Set performance analyzer for cache statistics
+    void set_performance_analyzer(PerformanceAnalyzer* analyzer) { perf_analyzer = analyzer; }
     
-    // Load memory from file
-    void load_program(const std::string& filename);
+    // Load an ELF executable or raw binary, returns false on failure
+    bool load_program(const std::string& filename);
+    
+    // Where execution starts (the ELF entry point, 0 for a raw binary)
+    Address get_entry_point() const { return program ? program->entry() : 0; }
+    
+    // Base ISA width the program was built for (32 or 64)
+    unsigned int get_xlen() const { return program ? program->xlen() : 64; }
+    
+    // Symbols of the loaded program (empty for a raw binary)
+    const SymbolTable& get_symbols() const { return symbols; }
     
 private:
-    // Memory storage (simplified for this example)
-    std::vector<uint8_t> memory;
+    // Guest memory, allocated a page at a time
+    SparseMemory* memory;
+    
+    // Mapped program file (may back guest text pages) and its symbols
+    ElfLoader* program;
+    SymbolTable symbols;
+    
+    // First-level caches (timing only, data lives in memory)
+    Cache* l1i;
+    Cache* l1d;
+    
+    // Outstanding misses of each cache
+    MSHRFile* l1i_mshrs;
+    MSHRFile* l1d_mshrs;
+    
+    // Unified L2 and main memory
+    Cache* l2;
+    MSHRFile* l2_mshrs;
+    Dram* dram;
+    
+    // Data prefetchers (nullptr when disabled)
+    Prefetcher* l1d_prefetcher;
+    Prefetcher* l2_prefetcher;
+    
+    // Address translation (nullptr without virtual memory). A single
+    // walker serves both TLBs and is busy until walker_free.
+    Tlb* itlb;
+    Tlb* dtlb;
+    Tlb* l2tlb;
+    PageTableWalker* walker;
+    uint64_t walker_free;
+    
+    // Current cycle, used to time outstanding fills
+    uint64_t cycle;
+    
+    // Performance analyzer
+    PerformanceAnalyzer* perf_analyzer;
+    
+    // Cycles until the translation of addr is available (0 without virtual memory)
+    unsigned int translate(Tlb* tlb, const std::string& label, Address addr);
+    
+    // Look up a cache at cycle start, record the outcome and return the
+    // access latency from start
+    unsigned int access_cache(Cache* cache, MSHRFile* mshrs, Prefetcher* prefetcher,
+                              const std::string& label, Address addr, bool is_write, Address pc,
+                              uint64_t start);
+    
+    // Cycles from start until the level below a cache can supply a line
+    unsigned int next_level_latency(Cache* cache, Address line, uint64_t start, Address pc);
+    
+    // Cycles from start until the L2 can supply a line
+    unsigned int fill_from_l2(Address addr, uint64_t start, Address pc);
+    
+    // Cycles from start until DRAM returns a line
+    unsigned int read_dram(Address line, uint64_t start);
+    
+    // Train a cache's prefetcher on a demand access and issue its requests
+    void run_prefetcher(Prefetcher* prefetcher, Cache* cache, MSHRFile* mshrs,
+                        const std::string& label, Address pc, Address addr, bool trigger);
+    
+    // Start a prefetch of one line unless it is present or already in flight
+    void issue_prefetch(Cache* cache, MSHRFile* mshrs, const std::string& label,
+                        Address line, Address pc);
     
-    // Memory parameters
-    static const size_t MEMORY_SIZE = 1024 * 1024; // 1MB
+    // Send a dirty victim of the named cache to the next level
+    void write_back(const std::string& label, const CacheEviction& eviction);
     
     // Process methods
     void memory_proc();
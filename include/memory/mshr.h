@@ -0,0 +1,53 @@
+#ifndef MSHR_H
+#define MSHR_H
+
+#include <systemc.h>
+#include <vector>
+#include "common/types.h"
+
+// An outstanding line fill
+struct MSHREntry {
+    Address line_addr;       // Line being filled
+    uint64_t fill_cycle;     // Cycle the line arrives
+    unsigned int targets;    // Accesses waiting on the fill (primary + merged)
+    bool prefetch;           // Requested by a prefetcher, no demand access yet
+};
+
+// Miss status holding registers for a non-blocking cache. Each entry tracks
+// one line in flight; later misses to the same line merge into it instead
+// of issuing another fill.
+class MSHRFile : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(MSHRFile);
+    MSHRFile(sc_module_name name, unsigned int entries);
+    
+    // Drop all outstanding misses
+    void reset();
+    
+    // Free the entries whose fills have arrived by the given cycle
+    void retire(uint64_t cycle);
+    
+    // Outstanding fill for a line, or nullptr
+    MSHREntry* find(Address line_addr);
+    const MSHREntry* find(Address line_addr) const;
+    
+    // Check if a new primary miss can be tracked
+    bool has_free() const { return entries.size() < max_entries; }
+    
+    // Track a primary miss or a prefetch
+    void allocate(Address line_addr, uint64_t fill_cycle, bool prefetch = false);
+    
+    // Cycle the next outstanding fill arrives (0 if none)
+    uint64_t earliest_fill() const;
+    
+    // Number of outstanding misses
+    unsigned int outstanding() const { return static_cast<unsigned int>(entries.size()); }
+    unsigned int capacity() const { return max_entries; }
+    
+private:
+    unsigned int max_entries;
+    std::vector<MSHREntry> entries;
+};
+
+#endif // MSHR_H
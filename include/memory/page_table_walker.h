@@ -0,0 +1,59 @@
+#ifndef PAGE_TABLE_WALKER_H
+#define PAGE_TABLE_WALKER_H
+
+#include <systemc.h>
+#include <vector>
+#include "common/types.h"
+#include "memory/sparse_memory.h"
+
+// Sv39 page tables and the hardware walker that reads them. There is no
+// supervisor software, so the simulator plays the operating system: the
+// tables live in guest memory above the 39-bit virtual range, and a walk
+// that reaches an invalid entry maps the page (identity, at the configured
+// page size) before finishing. The walker itself only reports which PTEs
+// it had to read; a page walk cache of non-leaf entries lets it skip the
+// upper levels.
+class PageTableWalker : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(PageTableWalker);
+    PageTableWalker(sc_module_name name, SparseMemory* memory, unsigned int page_shift,
+                    unsigned int pwc_entries);
+    
+    // Flush the page walk cache (the tables themselves persist)
+    void reset();
+    
+    // Walk the tables for vaddr, appending the physical addresses of the
+    // PTEs read from memory in order. Returns the leaf's page shift.
+    unsigned int walk(Address vaddr, std::vector<Address>& pte_reads);
+    
+private:
+    static const unsigned int LEVELS = 3;
+    static const uint64_t PTE_SIZE = 8;
+    
+    // A cached pointer to the page table serving one level of a VA range
+    struct PwcEntry {
+        bool valid;
+        unsigned int level;   // Level of the PTEs in the table
+        uint64_t tag;         // VA bits above that level
+        Address table;
+        uint64_t last_use;
+    };
+    
+    SparseMemory* memory;
+    unsigned int leaf_level;   // 0: 4 KB, 1: 2 MB, 2: 1 GB
+    Address root;
+    Address next_table;        // Bump allocator for page-table pages
+    
+    std::vector<PwcEntry> pwc;
+    uint64_t use_counter;
+    
+    // VA bits above the given level's VPN field
+    static uint64_t level_tag(Address vaddr, unsigned int level);
+    
+    Address allocate_table();
+    PwcEntry* pwc_lookup(Address vaddr, unsigned int level);
+    void pwc_insert(Address vaddr, unsigned int level, Address table);
+};
+
+#endif // PAGE_TABLE_WALKER_H
@@ -0,0 +1,57 @@
+#ifndef PREFETCHER_H
+#define PREFETCHER_H
+
+#include <systemc.h>
+#include <vector>
+#include "common/types.h"
+#include "common/config.h"
+
+// Hardware data prefetcher attached to one cache. It watches the demand
+// access stream and proposes lines to bring in ahead of use.
+class Prefetcher : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(Prefetcher);
+    Prefetcher(sc_module_name name, PrefetcherType type, unsigned int line_size,
+               unsigned int degree = 2, unsigned int table_size = 64);
+    
+    // Forget all training state
+    void reset();
+    
+    // Observe a demand access. trigger is set for misses and for first hits
+    // on prefetched lines. Candidate line addresses are appended to lines.
+    void observe(Address pc, Address addr, bool trigger, std::vector<Address>& lines);
+    
+    PrefetcherType get_type() const { return prefetcher_type; }
+    
+private:
+    // PC-indexed stride table entry
+    struct StrideEntry {
+        bool valid;
+        Address pc;
+        Address last_addr;
+        int64_t stride;
+        unsigned int confidence;   // Saturating, prefetch at 2 or more
+    };
+    
+    // Stream tracker
+    struct StreamEntry {
+        bool valid;
+        int64_t last_line;         // Line number of the last trigger
+        int direction;             // +1, -1, or 0 until the second miss
+        uint64_t last_use;
+    };
+    
+    PrefetcherType prefetcher_type;
+    unsigned int line_bytes;
+    unsigned int prefetch_degree;
+    
+    std::vector<StrideEntry> stride_table;
+    std::vector<StreamEntry> streams;
+    uint64_t access_count;
+    
+    void observe_stride(Address pc, Address addr, std::vector<Address>& lines);
+    void observe_stream(Address addr, std::vector<Address>& lines);
+};
+
+#endif // PREFETCHER_H
@@ -0,0 +1,77 @@
+#ifndef SPARSE_MEMORY_H
+#define SPARSE_MEMORY_H
+
+#include <systemc.h>
+#include <unordered_map>
+#include <vector>
+#include "common/types.h"
+
+// Sparse guest memory covering the full 64-bit address space. 4 KB pages
+// are allocated on the first write, carved out of large anonymous mappings
+// that the host zero-fills lazily; untouched pages read as zero.
+class SparseMemory : public sc_module {
+public:
+    static const uint64_t PAGE_SIZE = 4096;
+    
+    // Constructor
+    SC_HAS_PROCESS(SparseMemory);
+    SparseMemory(sc_module_name name);
+    
+    // Destructor
+    ~SparseMemory();
+    
+    // Byte access
+    uint8_t read_byte(Address addr) const;
+    void write_byte(Address addr, uint8_t value);
+    
+    // Little-endian access of 1, 2, 4 or 8 bytes, aligned or not
+    uint64_t read(Address addr, unsigned int size);
+    void write(Address addr, uint64_t value, unsigned int size);
+    
+    // Copy a block of bytes into guest memory
+    void load(Address addr, const uint8_t* data, size_t size);
+    
+    // Back the page at addr (page aligned) with caller-owned host memory
+    void map(Address addr, uint8_t* host);
+    
+    // Host storage for a guest page, or nullptr if it was never written
+    uint8_t* find_page(Address addr) const;
+    
+    // Host storage for a guest page, allocating it if needed
+    uint8_t* page(Address addr);
+    
+private:
+    // Pages carved from each anonymous mapping (2 MB, huge page sized)
+    static const size_t PAGES_PER_CHUNK = 512;
+    
+    // Direct-mapped cache of recent page translations, so back-to-back
+    // accesses to the same page skip the hash table
+    static const size_t PAGE_CACHE_ENTRIES = 64;
+    
+    struct PageCacheEntry {
+        uint64_t page_number;
+        uint8_t* host;
+        bool writable;    // false while host is the shared zero page
+    };
+    
+    // Guest page number -> host page
+    std::unordered_map<uint64_t, uint8_t*> pages;
+    
+    // Anonymous mappings and how many pages of the newest one are used
+    std::vector<uint8_t*> chunks;
+    size_t chunk_used;
+    
+    PageCacheEntry page_cache[PAGE_CACHE_ENTRIES];
+    
+    uint8_t* allocate_page();
+    
+    // Host page for reading (the zero page if unallocated) or writing
+    uint8_t* read_page(Address addr);
+    uint8_t* write_page(Address addr);
+    
+    // Byte-at-a-time path for accesses that straddle a page boundary
+    uint64_t read_bytes(Address addr, unsigned int size);
+    void write_bytes(Address addr, uint64_t value, unsigned int size);
+};
+
+#endif // SPARSE_MEMORY_H
@@ -0,0 +1,49 @@
+#ifndef TLB_H
+#define TLB_H
+
+#include <systemc.h>
+#include <vector>
+#include "common/types.h"
+#include "common/config.h"
+
+// A cached translation
+struct TlbEntry {
+    bool valid;
+    uint64_t vpn;              // Virtual page number at the entry's page size
+    unsigned int page_shift;   // 12, 21 or 30
+    uint64_t ready_cycle;      // Cycle the walk that filled it completes
+    uint64_t last_use;         // For LRU replacement
+};
+
+// Set-associative translation lookaside buffer holding pages of any Sv39
+// size. A lookup probes the set for each page size in turn. Translation is
+// identity, so entries only carry timing.
+class Tlb : public sc_module {
+public:
+    // Constructor
+    SC_HAS_PROCESS(Tlb);
+    Tlb(sc_module_name name, const TlbConfig& config);
+    
+    // Invalidate every entry
+    void reset();
+    
+    // Entry translating vaddr (updating LRU), or nullptr on a miss
+    TlbEntry* lookup(Address vaddr);
+    
+    // Install the translation of vaddr, replacing the set's LRU entry
+    void insert(Address vaddr, unsigned int page_shift, uint64_t ready_cycle);
+    
+    // Configuration
+    unsigned int get_hit_latency() const { return hit_latency; }
+    
+private:
+    unsigned int num_sets;
+    unsigned int num_ways;
+    unsigned int hit_latency;
+    uint64_t use_counter;
+    
+    // num_sets * num_ways entries, set-major
+    std::vector<TlbEntry> entries;
+};
+
+#endif // TLB_H
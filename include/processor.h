@@ -8,6 +8,7 @@
 #include "writeback/writeback_unit.h"
 #include "memory/memory_system.h"
 #include "common/types.h"
+#include "common/config.h"
 #include "common/performance_analyzer.h"
 
 class Processor : public sc_module {
@@ -18,13 +19,14 @@ public:
     
     // Constructor
     SC_HAS_PROCESS(Processor);
-    Processor(sc_module_name name, PredictorType predictor_type = PredictorType::TWO_BIT);
+    Processor(sc_module_name name, PredictorType predictor_type = PredictorType::TWO_BIT,
+              const ProcessorConfig& config = ProcessorConfig());
     
     // Destructor
     ~Processor();
     
-    // Load program from file
-    void load_program(const std::string& filename);
+    // Load an ELF executable or raw binary and point fetch at its entry
+    bool load_program(const std::string& filename);
     
     // Print simulation statistics
     void print_stats();
@@ -34,7 +36,7 @@ public:
     
     // Export performance data to CSV
     void export_performance_data(const std::string& filename = "performance_data.csv");
-
+    
 private:
     // Processor pipeline stages
     FetchUnit* fetchUnit;
@@ -42,6 +44,9 @@ private:
     ExecutionUnit* executionUnit;
     WritebackUnit* writebackUnit;
     
+    // Micro-op cache shared by fetch and decode (nullptr when disabled)
+    UopCache* uopCache;
+    
     // Memory system
     MemorySystem* memorySystem;
     
@@ -49,13 +54,13 @@ private:
     PerformanceAnalyzer* performanceAnalyzer;
     
     // Internal signals for communication between stages
-    sc_signal<FetchPacket> fetch_decode_channel;
-    sc_signal<DecodePacket> decode_exec_channel;
-    sc_signal<ExecutePacket> exec_writeback_channel;
+    sc_signal<FetchBundle> fetch_decode_channel;
+    sc_signal<DecodeBundle> decode_exec_channel;
+    sc_signal<DecodeBundle> uop_exec_channel;
+    sc_signal<ExecuteBundle> exec_writeback_channel;
     
     // Control signals
-    sc_signal<bool> stall_fetch;
-    sc_signal<bool> stall_decode;
+    sc_signal<bool> dispatch_stall;    // Raised by dispatch to hold fetch and decode
     sc_signal<bool> branch_taken;
     sc_signal<Address> branch_target;
     
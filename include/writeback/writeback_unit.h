@@ -9,7 +9,7 @@ public:
     // Ports
     sc_in<bool> clk;
     sc_in<bool> reset;
-    sc_in<ExecutePacket> execute_in;
+    sc_in<ExecuteBundle> execute_in;
     
     // Constructor
     SC_HAS_PROCESS(WritebackUnit);
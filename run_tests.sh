@@ -22,16 +22,15 @@ fi
 # Function to compile a test program
 compile_test() {
     local test_name="$1"
+    local march="${2:-rv32i}"
+    local mabi="${3:-ilp32}"
     echo "Compiling ${test_name}.s..."
     
     # Compile assembly to object file
-    riscv64-unknown-elf-gcc -march=rv32i -mabi=ilp32 -nostdlib -nostartfiles -T "${SCRIPT_DIR}/tests/link.ld" \
+    riscv64-unknown-elf-gcc -march=${march} -mabi=${mabi} -nostdlib -nostartfiles -T "${SCRIPT_DIR}/tests/link.ld" \
         "${TEST_DIR}/${test_name}.s" -o "${BIN_DIR}/${test_name}.elf"
     
-    # Extract binary
-    riscv64-unknown-elf-objcopy -O binary "${BIN_DIR}/${test_name}.elf" "${BIN_DIR}/${test_name}.bin"
-    
-    echo "Compiled ${test_name}.bin successfully."
+    echo "Compiled ${test_name}.elf successfully."
 }
 
 # Function to run a test
@@ -40,11 +39,12 @@ run_test() {
     local predictor_type="$2"
     local simulation_time="$3"
     local generate_report="$4"
+    local extra_args="$5"
     
     echo "Running test ${test_name} with predictor ${predictor_type}..."
     
     # Build command
-    cmd="${BUILD_DIR}/cakemu_ooo -f ${BIN_DIR}/${test_name}.bin -t ${simulation_time} -p ${predictor_type}"
+    cmd="${BUILD_DIR}/cakemu_ooo -f ${BIN_DIR}/${test_name}.elf -t ${simulation_time} -p ${predictor_type} ${extra_args}"
     
     # Add report generation if requested
     if [ "${generate_report}" = "true" ]; then
@@ -92,6 +92,10 @@ compile_test "branch_heavy_test"
 compile_test "memory_test"
 compile_test "alu_test"
 compile_test "comprehensive_test"
+compile_test "rv64i_test" rv64i lp64
+compile_test "muldiv_test" rv64im lp64
+compile_test "rvc_test" rv64ic lp64
+compile_test "fusion_test" rv64i lp64
 
 # Run tests with different branch predictors
 echo "Running tests with different branch predictors..."
@@ -100,11 +104,17 @@ echo "Running tests with different branch predictors..."
 predictors=("always_not_taken" "always_taken" "static_btfn" "one_bit" "two_bit" "gshare" "tournament")
 
 # Test each program with each predictor
-for test in "branch_heavy_test" "memory_test" "alu_test" "comprehensive_test"; do
+for test in "branch_heavy_test" "memory_test" "alu_test" "comprehensive_test" "rv64i_test" "muldiv_test" "rvc_test"; do
     echo "===== Testing ${test} ====="
     for predictor in "${predictors[@]}"; do
         run_test "${test}" "${predictor}" 10000 true
     done
 done
 
+# The fusion test is run with macro-op fusion enabled
+echo "===== Testing fusion_test ====="
+for predictor in "${predictors[@]}"; do
+    run_test "fusion_test" "${predictor}" 10000 true "--fusion on"
+done
+
 echo "All tests completed."
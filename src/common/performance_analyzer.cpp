@@ -11,10 +11,58 @@ PerformanceAnalyzer::PerformanceAnalyzer(sc_module_name name)
       total_cycles(0),
       total_memory_reads(0),
       total_memory_writes(0),
+      store_forwards(0),
+      load_blocks(0),
+      memory_order_violations(0),
+      memory_dependence_waits(0),
+      value_lookups(0),
+      value_predictions(0),
+      value_validated(0),
+      value_correct(0),
+      store_buffer_inserts(0),
+      store_buffer_combined(0),
+      store_buffer_samples(0),
+      store_buffer_occupancy_sum(0),
+      store_buffer_occupancy_max(0),
+      dram_reads(0),
+      dram_writes(0),
+      dram_read_latency_sum(0),
+      dram_queue_full(0),
+      page_walks(0),
+      page_walk_pte_reads(0),
+      page_walk_latency_sum(0),
+      ftq_samples(0),
+      ftq_occupancy_sum(0),
+      ftq_full_cycles(0),
+      ftq_occupancy_max(0),
+      ftq_capacity(0),
+      fetch_blocks(0),
+      fetch_block_instructions(0),
+      fetch_block_bytes(0),
+      compressed_instructions(0),
+      fused_pairs(0),
+      uop_lookups(0),
+      uop_hits(0),
+      uop_delivery_cycles(0),
+      uop_packets(0),
+      uop_instructions(0),
+      uop_switches(0),
+      uop_switch_cycles(0),
       data_hazards(0),
       control_hazards(0),
       structural_hazards(0),
-      pipeline_flushes(0) {
+      pipeline_flushes(0),
+      moves_eliminated(0),
+      zero_idioms_eliminated(0),
+      slots_total(0),
+      slots_used(0),
+      slots_squashed(0),
+      total_retired(0),
+      prf_samples(0),
+      prf_allocated_sum(0),
+      prf_allocated_max(0),
+      prf_size(0),
+      symbols(nullptr) {
     
     // Initialize statistics maps
     initialize_stats();
@@ -32,6 +80,8 @@ void PerformanceAnalyzer::initialize_stats() {
     opcode_stats[Opcode::OP_IMM] = InstructionStats();
     opcode_stats[Opcode::OP] = InstructionStats();
     opcode_stats[Opcode::SYSTEM] = InstructionStats();
+    opcode_stats[Opcode::OP_IMM_32] = InstructionStats();
+    opcode_stats[Opcode::OP_32] = InstructionStats();
     opcode_stats[Opcode::UNKNOWN] = InstructionStats();
     
     // Initialize instruction type stats
@@ -42,6 +92,30 @@ void PerformanceAnalyzer::initialize_stats() {
     type_stats[InstructionType::U_TYPE] = InstructionStats();
     type_stats[InstructionType::J_TYPE] = InstructionStats();
     type_stats[InstructionType::UNKNOWN] = InstructionStats();
+    
+    // Initialize dispatch stall counters
+    dispatch_stalls[DispatchStall::ROB_FULL] = 0;
+    dispatch_stalls[DispatchStall::RS_ALU_FULL] = 0;
+    dispatch_stalls[DispatchStall::RS_MEM_FULL] = 0;
+    dispatch_stalls[DispatchStall::RS_BRANCH_FULL] = 0;
+    dispatch_stalls[DispatchStall::LQ_FULL] = 0;
+    dispatch_stalls[DispatchStall::SQ_FULL] = 0;
+    dispatch_stalls[DispatchStall::FREE_LIST_EMPTY] = 0;
+    dispatch_stalls[DispatchStall::CHECKPOINTS_FULL] = 0;
+    
+    // Initialize retire stall counters
+    retire_stalls[RetireStall::ROB_EMPTY] = 0;
+    retire_stalls[RetireStall::HEAD_ALU] = 0;
+    retire_stalls[RetireStall::HEAD_LOAD] = 0;
+    retire_stalls[RetireStall::HEAD_STORE] = 0;
+    retire_stalls[RetireStall::HEAD_BRANCH] = 0;
+    retire_stalls[RetireStall::STORE_BUFFER_FULL] = 0;
+    retire_stalls[RetireStall::COMMIT_WIDTH] = 0;
+    
+    // Initialize row buffer counters
+    row_buffer_outcomes[RowBufferOutcome::HIT] = 0;
+    row_buffer_outcomes[RowBufferOutcome::EMPTY] = 0;
+    row_buffer_outcomes[RowBufferOutcome::CONFLICT] = 0;
 }
 
 void PerformanceAnalyzer::start_timing() {
@@ -104,6 +178,190 @@ void PerformanceAnalyzer::record_memory_access(bool is_read, Address addr) {
     }
 }
 
+void PerformanceAnalyzer::record_store_forward() {
+    store_forwards++;
+}
+
+void PerformanceAnalyzer::record_load_blocked() {
+    load_blocks++;
+}
+
+void PerformanceAnalyzer::record_memory_order_violation() {
+    memory_order_violations++;
+}
+
+void PerformanceAnalyzer::record_memory_dependence_wait() {
+    memory_dependence_waits++;
+}
+
+void PerformanceAnalyzer::record_value_lookup(bool predicted) {
+    value_lookups++;
+    if (predicted) {
+        value_predictions++;
+    }
+}
+
+void PerformanceAnalyzer::record_value_prediction(bool correct) {
+    value_validated++;
+    if (correct) {
+        value_correct++;
+    }
+}
+
+void PerformanceAnalyzer::record_store_buffer_insert(bool combined) {
+    store_buffer_inserts++;
+    if (combined) {
+        store_buffer_combined++;
+    }
+}
+
+void PerformanceAnalyzer::record_store_buffer_occupancy(unsigned int lines) {
+    store_buffer_samples++;
+    store_buffer_occupancy_sum += lines;
+    store_buffer_occupancy_max = std::max(store_buffer_occupancy_max, lines);
+}
+
+void PerformanceAnalyzer::record_cache_access(const std::string& cache, bool hit) {
+    CacheStats &stats = cache_stats[cache];
+    stats.accesses++;
+    if (hit) {
+        stats.hits++;
+    } else {
+        stats.misses++;
+    }
+}
+
+void PerformanceAnalyzer::record_cache_eviction(const std::string& cache, bool dirty) {
+    CacheStats &stats = cache_stats[cache];
+    stats.evictions++;
+    if (dirty) {
+        stats.writebacks++;
+    }
+}
+
+void PerformanceAnalyzer::record_mshr_merge(const std::string& cache) {
+    cache_stats[cache].mshr_merges++;
+}
+
+void PerformanceAnalyzer::record_mshr_full(const std::string& cache) {
+    cache_stats[cache].mshr_full++;
+}
+
+void PerformanceAnalyzer::record_mshr_occupancy(const std::string& cache, unsigned int outstanding) {
+    if (outstanding == 0) {
+        return;
+    }
+    
+    CacheStats &stats = cache_stats[cache];
+    stats.mshr_busy_cycles++;
+    stats.mshr_occupancy_sum += outstanding;
+    stats.mshr_peak = std::max(stats.mshr_peak, outstanding);
+}
+
+void PerformanceAnalyzer::record_prefetch_issued(const std::string& cache) {
+    prefetch_stats[cache].issued++;
+}
+
+void PerformanceAnalyzer::record_prefetch_useful(const std::string& cache, bool late) {
+    PrefetchStats &stats = prefetch_stats[cache];
+    stats.useful++;
+    if (late) {
+        stats.late++;
+    }
+}
+
+void PerformanceAnalyzer::record_prefetch_unused(const std::string& cache) {
+    prefetch_stats[cache].unused++;
+}
+
+void PerformanceAnalyzer::record_prefetch_dropped(const std::string& cache) {
+    prefetch_stats[cache].dropped++;
+}
+
+void PerformanceAnalyzer::record_dram_access(RowBufferOutcome outcome, bool is_write,
+                                             unsigned int latency, bool queued) {
+    if (is_write) {
+        dram_writes++;
+    } else {
+        dram_reads++;
+        dram_read_latency_sum += latency;
+    }
+    
+    row_buffer_outcomes[outcome]++;
+    if (queued) {
+        dram_queue_full++;
+    }
+}
+
+void PerformanceAnalyzer::record_data_latency(unsigned int cycles) {
+    size_t bucket = 0;
+    while (cycles > 1) {
+        cycles >>= 1;
+        bucket++;
+    }
+    
+    if (data_latency_histogram.size() <= bucket) {
+        data_latency_histogram.resize(bucket + 1, 0);
+    }
+    data_latency_histogram[bucket]++;
+}
+
+void PerformanceAnalyzer::record_tlb_access(const std::string& tlb, bool hit) {
+    TlbStats &stats = tlb_stats[tlb];
+    stats.accesses++;
+    if (hit) {
+        stats.hits++;
+    } else {
+        stats.misses++;
+    }
+}
+
+void PerformanceAnalyzer::record_page_walk(unsigned int pte_reads, unsigned int latency) {
+    page_walks++;
+    page_walk_pte_reads += pte_reads;
+    page_walk_latency_sum += latency;
+}
+
+void PerformanceAnalyzer::record_ftq_occupancy(unsigned int entries, unsigned int capacity) {
+    ftq_samples++;
+    ftq_occupancy_sum += entries;
+    ftq_occupancy_max = std::max(ftq_occupancy_max, entries);
+    ftq_capacity = capacity;
+    if (entries >= capacity) {
+        ftq_full_cycles++;
+    }
+}
+
+void PerformanceAnalyzer::record_fetch_block(unsigned int instructions, unsigned int compressed, unsigned int bytes) {
+    fetch_blocks++;
+    fetch_block_instructions += instructions;
+    fetch_block_bytes += bytes;
+    compressed_instructions += compressed;
+}
+
+void PerformanceAnalyzer::record_fusion(FusionKind kind) {
+    fusions[kind]++;
+    fused_pairs++;
+}
+
+void PerformanceAnalyzer::record_uop_lookup(bool hit) {
+    uop_lookups++;
+    if (hit) {
+        uop_hits++;
+    }
+}
+
+void PerformanceAnalyzer::record_uop_delivery(unsigned int packets, unsigned int instructions) {
+    uop_delivery_cycles++;
+    uop_packets += packets;
+    uop_instructions += instructions;
+}
+
+void PerformanceAnalyzer::record_uop_switch(unsigned int penalty) {
+    uop_switches++;
+    uop_switch_cycles += penalty;
+}
+
 void PerformanceAnalyzer::record_data_hazard() {
     data_hazards++;
 }
@@ -116,10 +374,76 @@ void PerformanceAnalyzer::record_structural_hazard() {
     structural_hazards++;
 }
 
+void PerformanceAnalyzer::record_structural_hazard(DispatchStall reason) {
+    structural_hazards++;
+    dispatch_stalls[reason]++;
+}
+
 void PerformanceAnalyzer::record_pipeline_flush() {
     pipeline_flushes++;
 }
 
+void PerformanceAnalyzer::record_dispatch(unsigned int count) {
+    if (count >= dispatch_histogram.size()) {
+        dispatch_histogram.resize(count + 1, 0);
+    }
+    dispatch_histogram[count]++;
+}
+
+void PerformanceAnalyzer::record_dispatch_slots(unsigned int used, unsigned int width, SlotLoss lost) {
+    slots_total += width;
+    slots_used += used;
+    if (used < width) {
+        slot_losses[lost] += width - used;
+    }
+}
+
+void PerformanceAnalyzer::record_squashed(unsigned int count) {
+    slots_squashed += count;
+}
+
+void PerformanceAnalyzer::record_elimination(EliminationKind kind) {
+    if (kind == EliminationKind::MOVE) {
+        moves_eliminated++;
+    } else if (kind == EliminationKind::ZERO_IDIOM) {
+        zero_idioms_eliminated++;
+    }
+}
+
+void PerformanceAnalyzer::record_retire(unsigned int count) {
+    if (count >= retire_histogram.size()) {
+        retire_histogram.resize(count + 1, 0);
+    }
+    retire_histogram[count]++;
+    total_retired += count;
+}
+
+void PerformanceAnalyzer::record_retired_pc(Address pc) {
+    if (symbols && !symbols->empty()) {
+        retired_pcs[pc]++;
+    }
+}
+
+void PerformanceAnalyzer::record_retire_stall(RetireStall reason) {
+    retire_stalls[reason]++;
+}
+
+void PerformanceAnalyzer::record_register_occupancy(unsigned int allocated, unsigned int total) {
+    prf_samples++;
+    prf_allocated_sum += allocated;
+    prf_allocated_max = std::max(prf_allocated_max, allocated);
+    prf_size = total;
+}
+
+void PerformanceAnalyzer::record_fu_issue(FUType type, unsigned int issued, unsigned int units) {
+    fu_ops[type] += issued;
+    fu_units[type] = units;
+}
+
+void PerformanceAnalyzer::record_fu_stall(FUType type) {
+    fu_stalls[type]++;
+}
+
 void PerformanceAnalyzer::print_summary() const {
     std::cout << "\n----- Performance Summary -----" << std::endl;
     
@@ -136,6 +460,160 @@ void PerformanceAnalyzer::print_summary() const {
     std::cout << "\nMemory Statistics:" << std::endl;
     std::cout << "  Total memory reads: " << total_memory_reads << std::endl;
     std::cout << "  Total memory writes: " << total_memory_writes << std::endl;
+    std::cout << "  Store-to-load forwards: " << store_forwards << std::endl;
+    std::cout << "  Loads blocked by partial overlap: " << load_blocks << std::endl;
+    std::cout << "  Memory ordering replays: " << memory_order_violations << std::endl;
+    std::cout << "  Memory dependence waits: " << memory_dependence_waits << std::endl;
+    
+    // Print load value prediction statistics
+    if (value_lookups > 0) {
+        std::cout << "\nLoad Value Prediction:" << std::endl;
+        std::cout << "  Loads looked up: " << value_lookups << std::endl;
+        std::cout << "  Values predicted: " << value_predictions << std::endl;
+        std::cout << "  Mispredictions: " << value_validated - value_correct << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "  Coverage: " << static_cast<double>(value_predictions) / value_lookups * 100.0 << "%" << std::endl;
+        if (value_validated > 0) {
+            std::cout << "  Accuracy: " << static_cast<double>(value_correct) / value_validated * 100.0 << "%" << std::endl;
+        }
+    }
+    
+    // Print store buffer statistics
+    if (store_buffer_samples > 0) {
+        std::cout << "\nStore Buffer:" << std::endl;
+        std::cout << "  Stores retired into buffer: " << store_buffer_inserts << std::endl;
+        std::cout << "  Stores combined into a buffered line: " << store_buffer_combined << std::endl;
+        std::cout << "  Average occupancy (lines): " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(store_buffer_occupancy_sum) / store_buffer_samples << std::endl;
+        std::cout << "  Peak occupancy (lines): " << store_buffer_occupancy_max << std::endl;
+    }
+    
+    // Print cache statistics
+    for (const auto& entry : cache_stats) {
+        const CacheStats &stats = entry.second;
+        double hit_rate = stats.accesses > 0 ?
+            static_cast<double>(stats.hits) / stats.accesses * 100.0 : 0.0;
+        std::cout << "\n" << entry.first << " Cache:" << std::endl;
+        std::cout << "  Accesses: " << stats.accesses << std::endl;
+        std::cout << "  Hits: " << stats.hits << " (" << std::fixed << std::setprecision(2)
+                  << hit_rate << "%)" << std::endl;
+        std::cout << "  Misses: " << stats.misses << std::endl;
+        std::cout << "  Evictions: " << stats.evictions << " (" << stats.writebacks << " dirty)" << std::endl;
+        std::cout << "  Secondary misses merged: " << stats.mshr_merges << std::endl;
+        std::cout << "  Accesses rejected (MSHRs full): " << stats.mshr_full << std::endl;
+        if (stats.mshr_busy_cycles > 0) {
+            std::cout << "  Memory-level parallelism: " << std::fixed << std::setprecision(2)
+                      << static_cast<double>(stats.mshr_occupancy_sum) / stats.mshr_busy_cycles
+                      << " (peak " << stats.mshr_peak << ")" << std::endl;
+        }
+    }
+    
+    // Print address translation statistics
+    for (const auto& entry : tlb_stats) {
+        const TlbStats &stats = entry.second;
+        std::cout << "\n" << entry.first << ":" << std::endl;
+        std::cout << "  Lookups: " << stats.accesses << std::endl;
+        std::cout << "  Hits: " << stats.hits << " (" << std::fixed << std::setprecision(2)
+                  << (stats.accesses > 0 ? static_cast<double>(stats.hits) / stats.accesses * 100.0 : 0.0)
+                  << "%)" << std::endl;
+        std::cout << "  Misses: " << stats.misses << std::endl;
+    }
+    if (page_walks > 0) {
+        std::cout << "\nPage Walks:" << std::endl;
+        std::cout << "  Walks: " << page_walks << std::endl;
+        std::cout << "  PTE reads per walk: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(page_walk_pte_reads) / page_walks << std::endl;
+        std::cout << "  Average walk latency: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(page_walk_latency_sum) / page_walks << " cycles" << std::endl;
+    }
+    
+    // Print fetch target queue occupancy
+    if (ftq_samples > 0) {
+        std::cout << "\nFetch Target Queue:" << std::endl;
+        std::cout << "  Entries: " << ftq_capacity << std::endl;
+        std::cout << "  Average occupancy: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(ftq_occupancy_sum) / ftq_samples << std::endl;
+        std::cout << "  Peak occupancy: " << ftq_occupancy_max << std::endl;
+        std::cout << "  Cycles full: " << ftq_full_cycles << std::endl;
+    }
+    
+    // Print fetch block size; compressed instructions fit more per line
+    if (fetch_blocks > 0) {
+        std::cout << "\nFetch Blocks:" << std::endl;
+        std::cout << "  Blocks delivered: " << fetch_blocks << std::endl;
+        std::cout << "  Average size: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(fetch_block_instructions) / fetch_blocks << " instructions, "
+                  << static_cast<double>(fetch_block_bytes) / fetch_blocks << " bytes" << std::endl;
+        std::cout << "  Compressed instructions: " << compressed_instructions << " ("
+                  << std::fixed << std::setprecision(2)
+                  << static_cast<double>(compressed_instructions) / fetch_block_instructions * 100.0
+                  << "%)" << std::endl;
+    }
+    
+    // Print macro-op fusion; the rate is the share of instructions from the
+    // decoders and the micro-op cache that were folded into a fused pair
+    uint64_t delivered_instructions = fetch_block_instructions + uop_instructions;
+    if (fused_pairs > 0 && delivered_instructions > 0) {
+        std::cout << "\nMacro-op Fusion:" << std::endl;
+        std::cout << "  Fused pairs: " << fused_pairs << " ("
+                  << std::fixed << std::setprecision(2)
+                  << static_cast<double>(2 * fused_pairs) / delivered_instructions * 100.0
+                  << "% of delivered instructions)" << std::endl;
+        for (const auto& entry : fusions) {
+            std::cout << "  " << fusion_kind_to_string(entry.first) << ": " << entry.second << std::endl;
+        }
+    }
+    
+    // Print micro-op cache coverage; the hit rate is per fetch block
+    if (uop_lookups > 0) {
+        std::cout << "\nMicro-op Cache:" << std::endl;
+        std::cout << "  Blocks: " << uop_lookups << ", hits: " << uop_hits << " ("
+                  << std::fixed << std::setprecision(2)
+                  << static_cast<double>(uop_hits) / uop_lookups * 100.0 << "%)" << std::endl;
+        if (uop_delivery_cycles > 0) {
+            std::cout << "  Packets delivered: " << uop_packets << " (" << std::fixed << std::setprecision(2)
+                      << static_cast<double>(uop_packets) / uop_delivery_cycles << " per delivery cycle)" << std::endl;
+        }
+        std::cout << "  Path switches: " << uop_switches << " (" << uop_switch_cycles
+                  << " penalty cycles)" << std::endl;
+    }
+    
+    // Print prefetcher effectiveness. Coverage counts misses the prefetcher
+    // removed (late prefetches still show up as misses in the cache stats).
+    for (const auto& entry : prefetch_stats) {
+        const PrefetchStats &stats = entry.second;
+        uint64_t misses = cache_stats.count(entry.first) ? cache_stats.at(entry.first).misses : 0;
+        uint64_t uncovered = misses > stats.late ? misses - stats.late : 0;
+        std::cout << "\n" << entry.first << " Prefetcher:" << std::endl;
+        std::cout << "  Issued: " << stats.issued << " (" << stats.dropped << " dropped, no MSHR)" << std::endl;
+        std::cout << "  Useful: " << stats.useful << " (" << stats.late << " late)" << std::endl;
+        std::cout << "  Evicted unused: " << stats.unused << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        if (stats.issued > 0) {
+            std::cout << "  Accuracy: " << static_cast<double>(stats.useful) / stats.issued * 100.0 << "%" << std::endl;
+        }
+        if (stats.useful + uncovered > 0) {
+            std::cout << "  Coverage: " << static_cast<double>(stats.useful) / (stats.useful + uncovered) * 100.0 << "%" << std::endl;
+        }
+        if (stats.useful > 0) {
+            std::cout << "  Timeliness: " << static_cast<double>(stats.useful - stats.late) / stats.useful * 100.0 << "%" << std::endl;
+        }
+    }
+    
+    // Print DRAM statistics
+    if (dram_reads + dram_writes > 0) {
+        std::cout << "\nDRAM:" << std::endl;
+        std::cout << "  Line reads: " << dram_reads << std::endl;
+        std::cout << "  Line writes: " << dram_writes << std::endl;
+        if (dram_reads > 0) {
+            std::cout << "  Average read latency: " << std::fixed << std::setprecision(2)
+                      << static_cast<double>(dram_read_latency_sum) / dram_reads << " cycles" << std::endl;
+        }
+        for (const auto& entry : row_buffer_outcomes) {
+            std::cout << "  Row buffer " << row_buffer_outcome_to_string(entry.first) << ": " << entry.second << std::endl;
+        }
+        std::cout << "  Requests delayed by a full queue: " << dram_queue_full << std::endl;
+    }
     
     // Print hazard statistics
     std::cout << "\nHazard Statistics:" << std::endl;
@@ -144,6 +622,71 @@ void PerformanceAnalyzer::print_summary() const {
     std::cout << "  Structural hazards: " << structural_hazards << std::endl;
     std::cout << "  Pipeline flushes: " << pipeline_flushes << std::endl;
     
+    // Print dispatch statistics
+    std::cout << "\nDispatch Statistics:" << std::endl;
+    for (const auto& entry : dispatch_stalls) {
+        std::cout << "  Stalls (" << dispatch_stall_to_string(entry.first) << "): " << entry.second << std::endl;
+    }
+    for (size_t i = 0; i < dispatch_histogram.size(); i++) {
+        std::cout << "  Cycles dispatching " << i << ": " << dispatch_histogram[i] << std::endl;
+    }
+    if (moves_eliminated + zero_idioms_eliminated > 0) {
+        std::cout << "  Moves eliminated: " << moves_eliminated << std::endl;
+        std::cout << "  Zero idioms eliminated: " << zero_idioms_eliminated << std::endl;
+    }
+    
+    // Print retire statistics
+    std::cout << "\nRetire Statistics:" << std::endl;
+    std::cout << "  Instructions retired: " << total_retired << std::endl;
+    if (total_cycles > 0) {
+        std::cout << "  Retire IPC: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(total_retired) / total_cycles << std::endl;
+    }
+    for (size_t i = 0; i < retire_histogram.size(); i++) {
+        std::cout << "  Cycles retiring " << i << ": " << retire_histogram[i] << std::endl;
+    }
+    for (const auto& entry : retire_stalls) {
+        std::cout << "  Head blocked (" << retire_stall_to_string(entry.first) << "): " << entry.second << std::endl;
+    }
+    
+    // Print top-down breakdown of dispatch slots
+    if (slots_total > 0) {
+        auto share = [this](uint64_t slots) { return static_cast<double>(slots) / slots_total * 100.0; };
+        uint64_t frontend = slot_loss(SlotLoss::FRONTEND);
+        uint64_t recovery = slot_loss(SlotLoss::RECOVERY);
+        uint64_t backend = slot_loss(SlotLoss::BACKEND_MEMORY) + slot_loss(SlotLoss::BACKEND_CORE);
+        
+        std::cout << "\nTop-Down (dispatch slots):" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "  Retiring: " << share(slots_used - slots_squashed) << "%" << std::endl;
+        std::cout << "  Bad speculation: " << share(slots_squashed + recovery) << "%" << std::endl;
+        std::cout << "  Frontend bound: " << share(frontend) << "%" << std::endl;
+        std::cout << "  Backend bound: " << share(backend) << "%" << std::endl;
+    }
+    
+    // Print physical register file occupancy
+    if (prf_samples > 0) {
+        std::cout << "\nPhysical Register File:" << std::endl;
+        std::cout << "  Registers: " << prf_size << std::endl;
+        std::cout << "  Average allocated: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(prf_allocated_sum) / prf_samples << std::endl;
+        std::cout << "  Peak allocated: " << prf_allocated_max << std::endl;
+    }
+    
+    // Print functional unit utilization
+    if (!fu_units.empty()) {
+        std::cout << "\nFunctional Units:" << std::endl;
+        for (const auto& entry : fu_units) {
+            uint64_t ops = fu_ops.count(entry.first) ? fu_ops.at(entry.first) : 0;
+            uint64_t stalls = fu_stalls.count(entry.first) ? fu_stalls.at(entry.first) : 0;
+            double utilization = total_cycles > 0 ?
+                static_cast<double>(ops) / (static_cast<double>(entry.second) * total_cycles) * 100.0 : 0.0;
+            std::cout << "  " << fu_type_to_string(entry.first) << " x" << entry.second
+                      << ": " << ops << " ops, " << std::fixed << std::setprecision(2) << utilization
+                      << "% utilized, " << stalls << " cycles waiting for a unit" << std::endl;
+        }
+    }
+    
     // Print instruction mix
     std::cout << "\nInstruction Mix:" << std::endl;
     for (const auto& entry : type_stats) {
@@ -188,6 +731,251 @@ void PerformanceAnalyzer::generate_detailed_report(const std::string& filename)
     report << "----------------" << std::endl;
     report << "Total memory reads: " << total_memory_reads << std::endl;
     report << "Total memory writes: " << total_memory_writes << std::endl;
+    report << "Store-to-load forwards: " << store_forwards << std::endl;
+    report << "Loads blocked by partial overlap: " << load_blocks << std::endl;
+    report << "Memory ordering replays: " << memory_order_violations << std::endl;
+    report << "Memory dependence waits: " << memory_dependence_waits << std::endl;
+    
+    // Load value prediction statistics; predictions on squashed loads are
+    // never checked, so accuracy counts validated predictions only
+    if (value_lookups > 0) {
+        report << "\nLoad Value Prediction" << std::endl;
+        report << "---------------------" << std::endl;
+        report << "Loads looked up: " << value_lookups << std::endl;
+        report << "Values predicted: " << value_predictions << std::endl;
+        report << "Predictions validated: " << value_validated << std::endl;
+        report << "Mispredictions: " << value_validated - value_correct << std::endl;
+        report << "Coverage: " << std::fixed << std::setprecision(2)
+               << static_cast<double>(value_predictions) / value_lookups * 100.0 << "%" << std::endl;
+        if (value_validated > 0) {
+            report << "Accuracy: " << std::fixed << std::setprecision(2)
+                   << static_cast<double>(value_correct) / value_validated * 100.0 << "%" << std::endl;
+        }
+    }
+    
+    // Store buffer statistics
+    if (store_buffer_samples > 0) {
+        report << "\nStore Buffer" << std::endl;
+        report << "------------" << std::endl;
+        report << "Stores retired into buffer: " << store_buffer_inserts << std::endl;
+        report << "Stores combined into a buffered line: " << store_buffer_combined << std::endl;
+        report << "Average occupancy (lines): " << std::fixed << std::setprecision(2)
+               << static_cast<double>(store_buffer_occupancy_sum) / store_buffer_samples << std::endl;
+        report << "Peak occupancy (lines): " << store_buffer_occupancy_max << std::endl;
+    }
+    
+    // Cache statistics
+    if (!cache_stats.empty()) {
+        report << "\nCache Statistics" << std::endl;
+        report << "----------------" << std::endl;
+        report << std::left << std::setw(8) << "Cache"
+               << std::right << std::setw(12) << "Accesses"
+               << std::right << std::setw(12) << "Hits"
+               << std::right << std::setw(12) << "Misses"
+               << std::right << std::setw(10) << "Hit %"
+               << std::right << std::setw(12) << "Evictions"
+               << std::right << std::setw(12) << "Writebacks"
+               << std::right << std::setw(10) << "Merged"
+               << std::right << std::setw(10) << "MSHRFull"
+               << std::right << std::setw(8) << "MLP" << std::endl;
+        for (const auto& entry : cache_stats) {
+            const CacheStats &stats = entry.second;
+            double hit_rate = stats.accesses > 0 ?
+                static_cast<double>(stats.hits) / stats.accesses * 100.0 : 0.0;
+            report << std::left << std::setw(8) << entry.first
+                   << std::right << std::setw(12) << stats.accesses
+                   << std::right << std::setw(12) << stats.hits
+                   << std::right << std::setw(12) << stats.misses
+                   << std::right << std::setw(10) << std::fixed << std::setprecision(2) << hit_rate
+                   << std::right << std::setw(12) << stats.evictions
+                   << std::right << std::setw(12) << stats.writebacks
+                   << std::right << std::setw(10) << stats.mshr_merges
+                   << std::right << std::setw(10) << stats.mshr_full
+                   << std::right << std::setw(8) << std::fixed << std::setprecision(2)
+                   << (stats.mshr_busy_cycles > 0 ?
+                       static_cast<double>(stats.mshr_occupancy_sum) / stats.mshr_busy_cycles : 0.0)
+                   << std::endl;
+        }
+    }
+    
+    // Address translation statistics
+    if (!tlb_stats.empty()) {
+        report << "\nTLB Statistics" << std::endl;
+        report << "--------------" << std::endl;
+        report << std::left << std::setw(8) << "TLB"
+               << std::right << std::setw(12) << "Lookups"
+               << std::right << std::setw(12) << "Hits"
+               << std::right << std::setw(12) << "Misses"
+               << std::right << std::setw(10) << "Hit %" << std::endl;
+        for (const auto& entry : tlb_stats) {
+            const TlbStats &stats = entry.second;
+            report << std::left << std::setw(8) << entry.first
+                   << std::right << std::setw(12) << stats.accesses
+                   << std::right << std::setw(12) << stats.hits
+                   << std::right << std::setw(12) << stats.misses
+                   << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+                   << (stats.accesses > 0 ? static_cast<double>(stats.hits) / stats.accesses * 100.0 : 0.0)
+                   << std::endl;
+        }
+        if (page_walks > 0) {
+            report << "Page walks: " << page_walks << std::endl;
+            report << "PTE reads per walk: " << std::fixed << std::setprecision(2)
+                   << static_cast<double>(page_walk_pte_reads) / page_walks << std::endl;
+            report << "Average walk latency: " << std::fixed << std::setprecision(2)
+                   << static_cast<double>(page_walk_latency_sum) / page_walks << " cycles" << std::endl;
+        }
+    }
+    
+    // Fetch target queue statistics
+    if (ftq_samples > 0) {
+        report << "\nFetch Target Queue" << std::endl;
+        report << "------------------" << std::endl;
+        report << "Entries: " << ftq_capacity << std::endl;
+        report << "Average occupancy: " << std::fixed << std::setprecision(2)
+               << static_cast<double>(ftq_occupancy_sum) / ftq_samples << std::endl;
+        report << "Peak occupancy: " << ftq_occupancy_max << std::endl;
+        report << "Cycles full: " << ftq_full_cycles << std::endl;
+    }
+    
+    // Fetch block statistics
+    if (fetch_blocks > 0) {
+        report << "\nFetch Blocks" << std::endl;
+        report << "------------" << std::endl;
+        report << "Blocks delivered: " << fetch_blocks << std::endl;
+        report << "Average instructions per block: " << std::fixed << std::setprecision(2)
+               << static_cast<double>(fetch_block_instructions) / fetch_blocks << std::endl;
+        report << "Average bytes per block: " << std::fixed << std::setprecision(2)
+               << static_cast<double>(fetch_block_bytes) / fetch_blocks << std::endl;
+        report << "Compressed instructions: " << compressed_instructions << " ("
+               << std::fixed << std::setprecision(2)
+               << static_cast<double>(compressed_instructions) / fetch_block_instructions * 100.0
+               << "%)" << std::endl;
+    }
+    
+    // Macro-op fusion statistics
+    uint64_t delivered_instructions = fetch_block_instructions + uop_instructions;
+    if (fused_pairs > 0 && delivered_instructions > 0) {
+        report << "\nMacro-op Fusion" << std::endl;
+        report << "---------------" << std::endl;
+        report << "Fused pairs: " << fused_pairs << std::endl;
+        report << "Fusion rate: " << std::fixed << std::setprecision(2)
+               << static_cast<double>(2 * fused_pairs) / delivered_instructions * 100.0
+               << "% of delivered instructions" << std::endl;
+        for (const auto& entry : fusions) {
+            report << std::left << std::setw(16) << fusion_kind_to_string(entry.first)
+                   << std::right << entry.second << std::endl;
+        }
+    }
+    
+    // Micro-op cache statistics
+    if (uop_lookups > 0) {
+        report << "\nMicro-op Cache" << std::endl;
+        report << "--------------" << std::endl;
+        report << "Fetch blocks: " << uop_lookups << std::endl;
+        report << "Hits: " << uop_hits << " (" << std::fixed << std::setprecision(2)
+               << static_cast<double>(uop_hits) / uop_lookups * 100.0 << "%)" << std::endl;
+        report << "Packets delivered: " << uop_packets << std::endl;
+        if (uop_delivery_cycles > 0) {
+            report << "Average packets per delivery cycle: " << std::fixed << std::setprecision(2)
+                   << static_cast<double>(uop_packets) / uop_delivery_cycles << std::endl;
+        }
+        report << "Path switches: " << uop_switches << std::endl;
+        report << "Switch penalty cycles: " << uop_switch_cycles << std::endl;
+    }
+    
+    // Prefetcher statistics
+    if (!prefetch_stats.empty()) {
+        report << "\nPrefetch Statistics" << std::endl;
+        report << "-------------------" << std::endl;
+        report << std::left << std::setw(8) << "Cache"
+               << std::right << std::setw(10) << "Issued"
+               << std::right << std::setw(10) << "Useful"
+               << std::right << std::setw(10) << "Late"
+               << std::right << std::setw(10) << "Unused"
+               << std::right << std::setw(10) << "Dropped"
+               << std::right << std::setw(11) << "Accuracy"
+               << std::right << std::setw(11) << "Coverage"
+               << std::right << std::setw(12) << "Timeliness" << std::endl;
+        for (const auto& entry : prefetch_stats) {
+            const PrefetchStats &stats = entry.second;
+            uint64_t misses = cache_stats.count(entry.first) ? cache_stats.at(entry.first).misses : 0;
+            uint64_t uncovered = misses > stats.late ? misses - stats.late : 0;
+            double accuracy = stats.issued > 0 ?
+                static_cast<double>(stats.useful) / stats.issued * 100.0 : 0.0;
+            double coverage = stats.useful + uncovered > 0 ?
+                static_cast<double>(stats.useful) / (stats.useful + uncovered) * 100.0 : 0.0;
+            double timeliness = stats.useful > 0 ?
+                static_cast<double>(stats.useful - stats.late) / stats.useful * 100.0 : 0.0;
+            report << std::left << std::setw(8) << entry.first
+                   << std::right << std::setw(10) << stats.issued
+                   << std::right << std::setw(10) << stats.useful
+                   << std::right << std::setw(10) << stats.late
+                   << std::right << std::setw(10) << stats.unused
+                   << std::right << std::setw(10) << stats.dropped
+                   << std::fixed << std::setprecision(2)
+                   << std::right << std::setw(11) << accuracy
+                   << std::right << std::setw(11) << coverage
+                   << std::right << std::setw(12) << timeliness << std::endl;
+        }
+    }
+    
+    // DRAM statistics
+    if (dram_reads + dram_writes > 0) {
+        report << "\nDRAM" << std::endl;
+        report << "----" << std::endl;
+        report << "Line reads: " << dram_reads << std::endl;
+        report << "Line writes: " << dram_writes << std::endl;
+        if (dram_reads > 0) {
+            report << "Average read latency: " << std::fixed << std::setprecision(2)
+                   << static_cast<double>(dram_read_latency_sum) / dram_reads << " cycles" << std::endl;
+        }
+        for (const auto& entry : row_buffer_outcomes) {
+            report << "Row buffer " << row_buffer_outcome_to_string(entry.first) << ": " << entry.second << std::endl;
+        }
+        report << "Requests delayed by a full queue: " << dram_queue_full << std::endl;
+    }
+    
+    // Data access latency distribution
+    uint64_t data_accesses = 0;
+    for (uint64_t count : data_latency_histogram) {
+        data_accesses += count;
+    }
+    if (data_accesses > 0) {
+        report << "\nData Access Latency" << std::endl;
+        report << "-------------------" << std::endl;
+        report << std::left << std::setw(15) << "Cycles"
+               << std::right << std::setw(10) << "Accesses"
+               << std::right << std::setw(10) << "%" << std::endl;
+        for (size_t i = 0; i < data_latency_histogram.size(); i++) {
+            uint64_t low = 1ULL << i;
+            std::string range = i == 0 ? "1" : std::to_string(low) + "-" + std::to_string(2 * low - 1);
+            report << std::left << std::setw(15) << range
+                   << std::right << std::setw(10) << data_latency_histogram[i]
+                   << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+                   << static_cast<double>(data_latency_histogram[i]) / data_accesses * 100.0 << std::endl;
+        }
+    }
+    
+    // Retired instructions by function of the loaded program
+    std::vector<std::pair<std::string, uint64_t>> functions = function_profile();
+    if (!functions.empty()) {
+        uint64_t profiled = 0;
+        for (const auto& entry : functions) {
+            profiled += entry.second;
+        }
+        
+        report << "\nFunction Profile" << std::endl;
+        report << "----------------" << std::endl;
+        report << std::left << std::setw(32) << "Function"
+               << std::right << std::setw(12) << "Retired"
+               << std::right << std::setw(10) << "%" << std::endl;
+        for (size_t i = 0; i < functions.size() && i < 20; i++) {
+            report << std::left << std::setw(32) << functions[i].first
+                   << std::right << std::setw(12) << functions[i].second
+                   << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+                   << static_cast<double>(functions[i].second) / profiled * 100.0 << std::endl;
+        }
+    }
     
     // Hazard statistics
     report << "\nHazard Statistics" << std::endl;
@@ -197,6 +985,147 @@ void PerformanceAnalyzer::generate_detailed_report(const std::string& filename)
     report << "Structural hazards: " << structural_hazards << std::endl;
     report << "Pipeline flushes: " << pipeline_flushes << std::endl;
     
+    // Dispatch statistics
+    report << "\nDispatch Statistics" << std::endl;
+    report << "-------------------" << std::endl;
+    for (const auto& entry : dispatch_stalls) {
+        report << "Stalls (" << dispatch_stall_to_string(entry.first) << "): " << entry.second << std::endl;
+    }
+    
+    uint64_t dispatch_cycles = 0;
+    uint64_t dispatched = 0;
+    for (size_t i = 0; i < dispatch_histogram.size(); i++) {
+        dispatch_cycles += dispatch_histogram[i];
+        dispatched += i * dispatch_histogram[i];
+    }
+    if (dispatch_cycles > 0) {
+        report << "Average dispatch width: " << std::fixed << std::setprecision(2)
+               << static_cast<double>(dispatched) / dispatch_cycles << std::endl;
+    }
+    
+    // Instructions resolved at rename never reach a reservation station
+    if (moves_eliminated + zero_idioms_eliminated > 0 && dispatched > 0) {
+        report << "Moves eliminated: " << moves_eliminated << " ("
+               << std::fixed << std::setprecision(2)
+               << static_cast<double>(moves_eliminated) / dispatched * 100.0 << "% of dispatched)" << std::endl;
+        report << "Zero idioms eliminated: " << zero_idioms_eliminated << " ("
+               << std::fixed << std::setprecision(2)
+               << static_cast<double>(zero_idioms_eliminated) / dispatched * 100.0 << "% of dispatched)" << std::endl;
+    }
+    report << std::left << std::setw(15) << "Dispatched"
+           << std::right << std::setw(10) << "Cycles"
+           << std::right << std::setw(10) << "%" << std::endl;
+    for (size_t i = 0; i < dispatch_histogram.size(); i++) {
+        double percentage = dispatch_cycles > 0 ?
+            static_cast<double>(dispatch_histogram[i]) / dispatch_cycles * 100.0 : 0.0;
+        report << std::left << std::setw(15) << i
+               << std::right << std::setw(10) << dispatch_histogram[i]
+               << std::right << std::setw(10) << std::fixed << std::setprecision(2) << percentage
+               << std::endl;
+    }
+    
+    // Retire statistics
+    report << "\nRetire Statistics" << std::endl;
+    report << "-----------------" << std::endl;
+    report << "Instructions retired: " << total_retired << std::endl;
+    if (total_cycles > 0) {
+        report << "Retire IPC: " << std::fixed << std::setprecision(2)
+               << static_cast<double>(total_retired) / total_cycles << std::endl;
+    }
+    
+    uint64_t retire_cycles = 0;
+    for (size_t i = 0; i < retire_histogram.size(); i++) {
+        retire_cycles += retire_histogram[i];
+    }
+    report << std::left << std::setw(15) << "Retired"
+           << std::right << std::setw(10) << "Cycles"
+           << std::right << std::setw(10) << "%" << std::endl;
+    for (size_t i = 0; i < retire_histogram.size(); i++) {
+        double percentage = retire_cycles > 0 ?
+            static_cast<double>(retire_histogram[i]) / retire_cycles * 100.0 : 0.0;
+        report << std::left << std::setw(15) << i
+               << std::right << std::setw(10) << retire_histogram[i]
+               << std::right << std::setw(10) << std::fixed << std::setprecision(2) << percentage
+               << std::endl;
+    }
+    
+    report << "\nROB head blocked cycles:" << std::endl;
+    for (const auto& entry : retire_stalls) {
+        double percentage = retire_cycles > 0 ?
+            static_cast<double>(entry.second) / retire_cycles * 100.0 : 0.0;
+        report << std::left << std::setw(15) << retire_stall_to_string(entry.first)
+               << std::right << std::setw(10) << entry.second
+               << std::right << std::setw(10) << std::fixed << std::setprecision(2) << percentage
+               << std::endl;
+    }
+    
+    // Top-down breakdown: every dispatch slot is retiring, bad speculation
+    // (squashed, or empty while refilling after a squash), frontend bound
+    // (empty for lack of decoded instructions) or backend bound (empty
+    // because dispatch was blocked), with the backend split by whether a
+    // memory operation held things up
+    if (slots_total > 0) {
+        uint64_t recovery = slot_loss(SlotLoss::RECOVERY);
+        uint64_t memory = slot_loss(SlotLoss::BACKEND_MEMORY);
+        uint64_t core = slot_loss(SlotLoss::BACKEND_CORE);
+        
+        const std::pair<std::string, uint64_t> rows[] = {
+            {"Retiring", slots_used - slots_squashed},
+            {"Bad speculation", slots_squashed + recovery},
+            {"  Squashed", slots_squashed},
+            {"  Recovery", recovery},
+            {"Frontend bound", slot_loss(SlotLoss::FRONTEND)},
+            {"Backend bound", memory + core},
+            {"  Memory bound", memory},
+            {"  Core bound", core}
+        };
+        
+        report << "\nTop-Down Analysis" << std::endl;
+        report << "-----------------" << std::endl;
+        report << "Dispatch slots: " << slots_total << std::endl;
+        report << std::left << std::setw(20) << "Category"
+               << std::right << std::setw(12) << "Slots"
+               << std::right << std::setw(10) << "%" << std::endl;
+        for (const auto& row : rows) {
+            report << std::left << std::setw(20) << row.first
+                   << std::right << std::setw(12) << row.second
+                   << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+                   << static_cast<double>(row.second) / slots_total * 100.0 << std::endl;
+        }
+    }
+    
+    // Physical register file occupancy
+    if (prf_samples > 0) {
+        report << "\nPhysical Register File" << std::endl;
+        report << "----------------------" << std::endl;
+        report << "Registers: " << prf_size << std::endl;
+        report << "Average allocated: " << std::fixed << std::setprecision(2)
+               << static_cast<double>(prf_allocated_sum) / prf_samples << std::endl;
+        report << "Peak allocated: " << prf_allocated_max << std::endl;
+    }
+    
+    // Functional unit utilization
+    if (!fu_units.empty()) {
+        report << "\nFunctional Units" << std::endl;
+        report << "----------------" << std::endl;
+        report << std::left << std::setw(15) << "Unit"
+               << std::right << std::setw(10) << "Count"
+               << std::right << std::setw(10) << "Ops"
+               << std::right << std::setw(15) << "Utilization %"
+               << std::right << std::setw(15) << "Unit Stalls" << std::endl;
+        for (const auto& entry : fu_units) {
+            uint64_t ops = fu_ops.count(entry.first) ? fu_ops.at(entry.first) : 0;
+            uint64_t stalls = fu_stalls.count(entry.first) ? fu_stalls.at(entry.first) : 0;
+            double utilization = total_cycles > 0 ?
+                static_cast<double>(ops) / (static_cast<double>(entry.second) * total_cycles) * 100.0 : 0.0;
+            report << std::left << std::setw(15) << fu_type_to_string(entry.first)
+                   << std::right << std::setw(10) << entry.second
+                   << std::right << std::setw(10) << ops
+                   << std::right << std::setw(15) << std::fixed << std::setprecision(2) << utilization
+                   << std::right << std::setw(15) << stalls << std::endl;
+        }
+    }
+    
     // Instruction statistics by opcode
     report << "\nInstruction Statistics by Opcode" << std::endl;
     report << "-------------------------------" << std::endl;
@@ -283,6 +1212,32 @@ void PerformanceAnalyzer::generate_histogram() const {
                       << std::endl;
         }
     }
+    
+    // Data access latency, one bar per power-of-two bucket
+    uint64_t data_accesses = 0;
+    uint64_t max_bucket = 0;
+    for (uint64_t count : data_latency_histogram) {
+        data_accesses += count;
+        max_bucket = std::max(max_bucket, count);
+    }
+    
+    if (data_accesses > 0) {
+        std::cout << "\nData Access Latency Histogram (cycles)" << std::endl;
+        std::cout << "--------------------------------------" << std::endl;
+        
+        for (size_t i = 0; i < data_latency_histogram.size(); i++) {
+            uint64_t low = 1ULL << i;
+            std::string range = i == 0 ? "1" : std::to_string(low) + "-" + std::to_string(2 * low - 1);
+            int bar_width = static_cast<int>(static_cast<double>(data_latency_histogram[i]) / max_bucket * max_width);
+            double percentage = static_cast<double>(data_latency_histogram[i]) / data_accesses * 100.0;
+            
+            std::cout << std::left << std::setw(10) << range
+                      << " [" << std::string(bar_width, '#') << std::string(max_width - bar_width, ' ') << "] "
+                      << std::right << std::setw(8) << data_latency_histogram[i]
+                      << " (" << std::fixed << std::setprecision(2) << percentage << "%)"
+                      << std::endl;
+        }
+    }
 }
 
 void PerformanceAnalyzer::export_csv(const std::string& filename) const {
@@ -329,6 +1284,65 @@ void PerformanceAnalyzer::export_csv(const std::string& filename) const {
     csv << "Hazard,Structural," << structural_hazards << ",,,,,," << std::endl;
     csv << "Hazard,PipelineFlush," << pipeline_flushes << ",,,,,," << std::endl;
     
+    // Write dispatch statistics
+    for (const auto& entry : dispatch_stalls) {
+        csv << "DispatchStall," << dispatch_stall_to_string(entry.first) << "," << entry.second << ",,,,,," << std::endl;
+    }
+    for (size_t i = 0; i < dispatch_histogram.size(); i++) {
+        csv << "DispatchWidth," << i << "," << dispatch_histogram[i] << ",,,,,," << std::endl;
+    }
+    if (moves_eliminated + zero_idioms_eliminated > 0) {
+        csv << "Elimination,Moves," << moves_eliminated << ",,,,,," << std::endl;
+        csv << "Elimination,ZeroIdioms," << zero_idioms_eliminated << ",,,,,," << std::endl;
+    }
+    
+    // Write retire statistics
+    csv << "Retire,Instructions," << total_retired << ",,,,,," << std::endl;
+    for (size_t i = 0; i < retire_histogram.size(); i++) {
+        csv << "RetireWidth," << i << "," << retire_histogram[i] << ",,,,,," << std::endl;
+    }
+    for (const auto& entry : retire_stalls) {
+        csv << "RetireStall," << retire_stall_to_string(entry.first) << "," << entry.second << ",,,,,," << std::endl;
+    }
+    
+    // Write the top-down breakdown, level-two categories named Parent/Child
+    if (slots_total > 0) {
+        uint64_t recovery = slot_loss(SlotLoss::RECOVERY);
+        uint64_t memory = slot_loss(SlotLoss::BACKEND_MEMORY);
+        uint64_t core = slot_loss(SlotLoss::BACKEND_CORE);
+        
+        const std::pair<std::string, uint64_t> rows[] = {
+            {"Slots", slots_total},
+            {"Retiring", slots_used - slots_squashed},
+            {"BadSpeculation", slots_squashed + recovery},
+            {"BadSpeculation/Squashed", slots_squashed},
+            {"BadSpeculation/Recovery", recovery},
+            {"FrontendBound", slot_loss(SlotLoss::FRONTEND)},
+            {"BackendBound", memory + core},
+            {"BackendBound/Memory", memory},
+            {"BackendBound/Core", core}
+        };
+        for (const auto& row : rows) {
+            csv << "TopDown," << row.first << "," << row.second << ","
+                << static_cast<double>(row.second) / slots_total * 100.0 << ",,,," << std::endl;
+        }
+    }
+    
+    // Write physical register file occupancy
+    if (prf_samples > 0) {
+        csv << "PRF,Registers," << prf_size << ",,,,,," << std::endl;
+        csv << "PRF,AverageAllocated," << static_cast<double>(prf_allocated_sum) / prf_samples << ",,,,,," << std::endl;
+        csv << "PRF,PeakAllocated," << prf_allocated_max << ",,,,,," << std::endl;
+    }
+    
+    // Write functional unit statistics
+    for (const auto& entry : fu_units) {
+        std::string unit = fu_type_to_string(entry.first);
+        csv << "FU," << unit << "Units," << entry.second << ",,,,,," << std::endl;
+        csv << "FU," << unit << "Ops," << (fu_ops.count(entry.first) ? fu_ops.at(entry.first) : 0) << ",,,,,," << std::endl;
+        csv << "FU," << unit << "Stalls," << (fu_stalls.count(entry.first) ? fu_stalls.at(entry.first) : 0) << ",,,,,," << std::endl;
+    }
+    
     // Write overall statistics
     csv << "Overall,Instructions," << total_instructions << ",,,,,," << std::endl;
     csv << "Overall,Cycles," << total_cycles << ",,,,,," << std::endl;
@@ -338,6 +1352,122 @@ void PerformanceAnalyzer::export_csv(const std::string& filename) const {
     }
     csv << "Memory,Reads," << total_memory_reads << ",,,,,," << std::endl;
     csv << "Memory,Writes," << total_memory_writes << ",,,,,," << std::endl;
+    csv << "Memory,StoreForwards," << store_forwards << ",,,,,," << std::endl;
+    csv << "Memory,LoadBlocks," << load_blocks << ",,,,,," << std::endl;
+    csv << "Memory,OrderingReplays," << memory_order_violations << ",,,,,," << std::endl;
+    csv << "Memory,DependenceWaits," << memory_dependence_waits << ",,,,,," << std::endl;
+    
+    // Write load value prediction statistics
+    if (value_lookups > 0) {
+        csv << "ValuePrediction,Lookups," << value_lookups << ",,,,,," << std::endl;
+        csv << "ValuePrediction,Predicted," << value_predictions << ",,,,,," << std::endl;
+        csv << "ValuePrediction,Validated," << value_validated << ",,,,,," << std::endl;
+        csv << "ValuePrediction,Correct," << value_correct << ",,,,,," << std::endl;
+        csv << "ValuePrediction,Coverage," << static_cast<double>(value_predictions) / value_lookups << ",,,,,," << std::endl;
+        if (value_validated > 0) {
+            csv << "ValuePrediction,Accuracy," << static_cast<double>(value_correct) / value_validated << ",,,,,," << std::endl;
+        }
+    }
+    
+    // Write store buffer statistics
+    if (store_buffer_samples > 0) {
+        csv << "StoreBuffer,Stores," << store_buffer_inserts << ",,,,,," << std::endl;
+        csv << "StoreBuffer,Combined," << store_buffer_combined << ",,,,,," << std::endl;
+        csv << "StoreBuffer,AverageOccupancy," << static_cast<double>(store_buffer_occupancy_sum) / store_buffer_samples << ",,,,,," << std::endl;
+        csv << "StoreBuffer,PeakOccupancy," << store_buffer_occupancy_max << ",,,,,," << std::endl;
+    }
+    
+    // Write cache statistics
+    for (const auto& entry : cache_stats) {
+        const CacheStats &stats = entry.second;
+        csv << "Cache," << entry.first << "Accesses," << stats.accesses << ",,,,,," << std::endl;
+        csv << "Cache," << entry.first << "Hits," << stats.hits << ",,,,,," << std::endl;
+        csv << "Cache," << entry.first << "Misses," << stats.misses << ",,,,,," << std::endl;
+        csv << "Cache," << entry.first << "Evictions," << stats.evictions << ",,,,,," << std::endl;
+        csv << "Cache," << entry.first << "Writebacks," << stats.writebacks << ",,,,,," << std::endl;
+        csv << "Cache," << entry.first << "MSHRMerges," << stats.mshr_merges << ",,,,,," << std::endl;
+        csv << "Cache," << entry.first << "MSHRFull," << stats.mshr_full << ",,,,,," << std::endl;
+        csv << "Cache," << entry.first << "MSHRBusyCycles," << stats.mshr_busy_cycles << ",,,,,," << std::endl;
+        csv << "Cache," << entry.first << "MSHROccupancy," << stats.mshr_occupancy_sum << ",,,,,," << std::endl;
+    }
+    
+    // Write address translation statistics
+    for (const auto& entry : tlb_stats) {
+        csv << "TLB," << entry.first << "Lookups," << entry.second.accesses << ",,,,,," << std::endl;
+        csv << "TLB," << entry.first << "Hits," << entry.second.hits << ",,,,,," << std::endl;
+        csv << "TLB," << entry.first << "Misses," << entry.second.misses << ",,,,,," << std::endl;
+    }
+    if (page_walks > 0) {
+        csv << "PageWalk,Walks," << page_walks << ",,,,,," << std::endl;
+        csv << "PageWalk,PTEReads," << page_walk_pte_reads << ",,,,,," << std::endl;
+        csv << "PageWalk,LatencySum," << page_walk_latency_sum << ",,,,,," << std::endl;
+    }
+    
+    // Write fetch target queue statistics
+    if (ftq_samples > 0) {
+        csv << "FTQ,AverageOccupancy," << static_cast<double>(ftq_occupancy_sum) / ftq_samples << ",,,,,," << std::endl;
+        csv << "FTQ,PeakOccupancy," << ftq_occupancy_max << ",,,,,," << std::endl;
+        csv << "FTQ,FullCycles," << ftq_full_cycles << ",,,,,," << std::endl;
+    }
+    
+    // Write fetch block statistics
+    if (fetch_blocks > 0) {
+        csv << "FetchBlocks,Blocks," << fetch_blocks << ",,,,,," << std::endl;
+        csv << "FetchBlocks,Instructions," << fetch_block_instructions << ",,,,,," << std::endl;
+        csv << "FetchBlocks,Bytes," << fetch_block_bytes << ",,,,,," << std::endl;
+        csv << "FetchBlocks,Compressed," << compressed_instructions << ",,,,,," << std::endl;
+    }
+    
+    // Write macro-op fusion statistics
+    if (fused_pairs > 0) {
+        csv << "Fusion,FusedPairs," << fused_pairs << ",,,,,," << std::endl;
+        uint64_t delivered_instructions = fetch_block_instructions + uop_instructions;
+        if (delivered_instructions > 0) {
+            csv << "Fusion,Rate," << static_cast<double>(2 * fused_pairs) / delivered_instructions
+                << ",,,,,," << std::endl;
+        }
+        for (const auto& entry : fusions) {
+            csv << "Fusion," << fusion_kind_to_string(entry.first) << "," << entry.second << ",,,,,," << std::endl;
+        }
+    }
+    
+    // Write micro-op cache statistics
+    if (uop_lookups > 0) {
+        csv << "UopCache,Blocks," << uop_lookups << ",,,,,," << std::endl;
+        csv << "UopCache,Hits," << uop_hits << ",,,,,," << std::endl;
+        csv << "UopCache,HitRate," << static_cast<double>(uop_hits) / uop_lookups << ",,,,,," << std::endl;
+        csv << "UopCache,Packets," << uop_packets << ",,,,,," << std::endl;
+        csv << "UopCache,DeliveryCycles," << uop_delivery_cycles << ",,,,,," << std::endl;
+        csv << "UopCache,Switches," << uop_switches << ",,,,,," << std::endl;
+        csv << "UopCache,SwitchPenaltyCycles," << uop_switch_cycles << ",,,,,," << std::endl;
+    }
+    
+    // Write prefetcher statistics
+    for (const auto& entry : prefetch_stats) {
+        const PrefetchStats &stats = entry.second;
+        csv << "Prefetch," << entry.first << "Issued," << stats.issued << ",,,,,," << std::endl;
+        csv << "Prefetch," << entry.first << "Useful," << stats.useful << ",,,,,," << std::endl;
+        csv << "Prefetch," << entry.first << "Late," << stats.late << ",,,,,," << std::endl;
+        csv << "Prefetch," << entry.first << "Unused," << stats.unused << ",,,,,," << std::endl;
+        csv << "Prefetch," << entry.first << "Dropped," << stats.dropped << ",,,,,," << std::endl;
+    }
+    
+    // Write DRAM statistics and the data access latency distribution
+    csv << "DRAM,Reads," << dram_reads << ",,,,,," << std::endl;
+    csv << "DRAM,Writes," << dram_writes << ",,,,,," << std::endl;
+    csv << "DRAM,ReadLatencySum," << dram_read_latency_sum << ",,,,,," << std::endl;
+    csv << "DRAM,QueueFull," << dram_queue_full << ",,,,,," << std::endl;
+    for (const auto& entry : row_buffer_outcomes) {
+        csv << "DRAM,Row" << row_buffer_outcome_to_string(entry.first) << "," << entry.second << ",,,,,," << std::endl;
+    }
+    for (size_t i = 0; i < data_latency_histogram.size(); i++) {
+        csv << "DataLatency," << (1ULL << i) << "," << data_latency_histogram[i] << ",,,,,," << std::endl;
+    }
+    
+    // Write the per-function retired instruction profile
+    for (const auto& entry : function_profile()) {
+        csv << "Function," << entry.first << "," << entry.second << ",,,,,," << std::endl;
+    }
     
     csv.close();
     std::cout << "CSV data exported to " << filename << std::endl;
@@ -357,6 +1487,8 @@ Opcode PerformanceAnalyzer::extract_opcode(Instruction inst) {
         case 0b0010011: return Opcode::OP_IMM;
         case 0b0110011: return Opcode::OP;
         case 0b1110011: return Opcode::SYSTEM;
+        case 0b0011011: return Opcode::OP_IMM_32;
+        case 0b0111011: return Opcode::OP_32;
         default: return Opcode::UNKNOWN;
     }
 }
@@ -364,8 +1496,10 @@ Opcode PerformanceAnalyzer::extract_opcode(Instruction inst) {
 InstructionType PerformanceAnalyzer::get_instruction_type(Opcode opcode) {
     switch (opcode) {
         case Opcode::OP:
+        case Opcode::OP_32:
             return InstructionType::R_TYPE;
         case Opcode::OP_IMM:
+        case Opcode::OP_IMM_32:
         case Opcode::LOAD:
         case Opcode::JALR:
             return InstructionType::I_TYPE;
@@ -395,6 +1529,8 @@ std::string PerformanceAnalyzer::opcode_to_string(Opcode opcode) const {
         case Opcode::OP_IMM: return "OP_IMM";
         case Opcode::OP: return "OP";
         case Opcode::SYSTEM: return "SYSTEM";
+        case Opcode::OP_IMM_32: return "OP_IMM_32";
+        case Opcode::OP_32: return "OP_32";
         default: return "UNKNOWN";
     }
 }
@@ -410,3 +1546,81 @@ std::string PerformanceAnalyzer::type_to_string(InstructionType type) const {
         default: return "UNKNOWN";
     }
 }
+
+uint64_t PerformanceAnalyzer::slot_loss(SlotLoss loss) const {
+    auto it = slot_losses.find(loss);
+    return it != slot_losses.end() ? it->second : 0;
+}
+
+std::string PerformanceAnalyzer::dispatch_stall_to_string(DispatchStall reason) const {
+    switch (reason) {
+        case DispatchStall::ROB_FULL: return "ROB_FULL";
+        case DispatchStall::RS_ALU_FULL: return "RS_ALU_FULL";
+        case DispatchStall::RS_MEM_FULL: return "RS_MEM_FULL";
+        case DispatchStall::RS_BRANCH_FULL: return "RS_BRANCH_FULL";
+        case DispatchStall::LQ_FULL: return "LQ_FULL";
+        case DispatchStall::SQ_FULL: return "SQ_FULL";
+        case DispatchStall::FREE_LIST_EMPTY: return "FREE_LIST_EMPTY";
+        case DispatchStall::CHECKPOINTS_FULL: return "CHECKPOINTS_FULL";
+        default: return "UNKNOWN";
+    }
+}
+
+std::string PerformanceAnalyzer::retire_stall_to_string(RetireStall reason) const {
+    switch (reason) {
+        case RetireStall::ROB_EMPTY: return "ROB_EMPTY";
+        case RetireStall::HEAD_ALU: return "HEAD_ALU";
+        case RetireStall::HEAD_LOAD: return "HEAD_LOAD";
+        case RetireStall::HEAD_STORE: return "HEAD_STORE";
+        case RetireStall::HEAD_BRANCH: return "HEAD_BRANCH";
+        case RetireStall::STORE_BUFFER_FULL: return "STORE_BUFFER_FULL";
+        case RetireStall::COMMIT_WIDTH: return "COMMIT_WIDTH";
+        default: return "UNKNOWN";
+    }
+}
+
+std::string PerformanceAnalyzer::fu_type_to_string(FUType type) const {
+    switch (type) {
+        case FUType::ALU: return "ALU";
+        case FUType::AGU: return "AGU";
+        case FUType::BRANCH: return "BRANCH";
+        case FUType::MUL: return "MUL";
+        case FUType::DIV: return "DIV";
+        default: return "UNKNOWN";
+    }
+}
+
+std::string PerformanceAnalyzer::fusion_kind_to_string(FusionKind kind) const {
+    switch (kind) {
+        case FusionKind::LOAD_IMMEDIATE: return "LUI+ADDI";
+        case FusionKind::PC_RELATIVE: return "AUIPC+ADDI";
+        case FusionKind::CALL: return "AUIPC+JALR";
+        case FusionKind::SHIFT_EXTEND: return "SLLI+SRLI";
+        case FusionKind::COMPARE_BRANCH: return "SLT+BRANCH";
+        default: return "NONE";
+    }
+}
+
+std::string PerformanceAnalyzer::row_buffer_outcome_to_string(RowBufferOutcome outcome) const {
+    switch (outcome) {
+        case RowBufferOutcome::HIT: return "Hit";
+        case RowBufferOutcome::EMPTY: return "Empty";
+        case RowBufferOutcome::CONFLICT: return "Conflict";
+        default: return "Unknown";
+    }
+}
+
+std::vector<std::pair<std::string, uint64_t>> PerformanceAnalyzer::function_profile() const {
+    std::map<std::string, uint64_t> totals;
+    for (const auto& entry : retired_pcs) {
+        const std::string* name = symbols ? symbols->lookup(entry.first) : nullptr;
+        totals[name ? *name : "(unknown)"] += entry.second;
+    }
+    
+    std::vector<std::pair<std::string, uint64_t>> profile(totals.begin(), totals.end());
+    std::stable_sort(profile.begin(), profile.end(),
+                     [](const std::pair<std::string, uint64_t>& a, const std::pair<std::string, uint64_t>& b) {
+                         return a.second > b.second;
+                     });
+    return profile;
+}
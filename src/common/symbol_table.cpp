@@ -0,0 +1,29 @@
+#include "common/symbol_table.h"
+
+void SymbolTable::add(const std::string& name, Address addr, uint64_t size) {
+    auto it = symbols.find(addr);
+    if (it != symbols.end()) {
+        // Several names for one address: keep the sized one (a function
+        // rather than a bare label)
+        if (it->second.size != 0 || size == 0) {
+            return;
+        }
+    }
+    
+    symbols[addr] = {name, size};
+}
+
+const std::string* SymbolTable::lookup(Address addr) const {
+    // Last symbol starting at or before addr
+    auto it = symbols.upper_bound(addr);
+    if (it == symbols.begin()) {
+        return nullptr;
+    }
+    --it;
+    
+    if (it->second.size != 0 && addr - it->first >= it->second.size) {
+        return nullptr;
+    }
+    
+    return &it->second.name;
+}
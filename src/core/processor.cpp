@@ -1,19 +1,33 @@
 #include "processor.h"
+#include "decode/compressed.h"
 #include <iostream>
 #include <iomanip>
 
-Processor::Processor(sc_module_name name, PredictorType predictor_type) : sc_module(name) {
+Processor::Processor(sc_module_name name, PredictorType predictor_type, const ProcessorConfig& config)
+    : sc_module(name) {
     // Create pipeline stages
-    fetchUnit = new FetchUnit("fetch_unit", predictor_type);
-    decodeUnit = new DecodeUnit("decode_unit");
-    executionUnit = new ExecutionUnit("execution_unit");
+    fetchUnit = new FetchUnit("fetch_unit", predictor_type, config.pipeline_width,
+                              config.l1i.line_size, config.ftq_size);
+    decodeUnit = new DecodeUnit("decode_unit", config.macro_fusion);
+    executionUnit = new ExecutionUnit("execution_unit", config);
     writebackUnit = new WritebackUnit("writeback_unit");
     
+    // Micro-op cache: decode fills it, fetch delivers from it
+    uopCache = nullptr;
+    if (config.uop_cache.entries > 0) {
+        uopCache = new UopCache("uop_cache", config.uop_cache);
+        fetchUnit->set_uop_cache(uopCache, config.uop_cache.width, config.uop_cache.switch_penalty);
+        decodeUnit->set_uop_cache(uopCache);
+    }
+    
     // Create memory system
-    memorySystem = new MemorySystem("memory_system");
+    memorySystem = new MemorySystem("memory_system", config);
     
     // Create performance analyzer
     performanceAnalyzer = new PerformanceAnalyzer("performance_analyzer");
+    fetchUnit->set_performance_analyzer(performanceAnalyzer);
+    executionUnit->set_performance_analyzer(performanceAnalyzer);
+    memorySystem->set_performance_analyzer(performanceAnalyzer);
     
     // Initialize statistics
     total_instructions = 0;
@@ -38,17 +52,18 @@ Processor::Processor(sc_module_name name, PredictorType predictor_type) : sc_mod
     memorySystem->reset(reset);
     
     // Initialize signal channels
-    FetchPacket empty_fetch_packet;
-    empty_fetch_packet.valid = false;
-    fetch_decode_channel.write(empty_fetch_packet);
+    FetchBundle empty_fetch_bundle;
+    empty_fetch_bundle.count = 0;
+    fetch_decode_channel.write(empty_fetch_bundle);
     
-    DecodePacket empty_decode_packet;
-    empty_decode_packet.valid = false;
-    decode_exec_channel.write(empty_decode_packet);
+    DecodeBundle empty_decode_bundle;
+    empty_decode_bundle.count = 0;
+    decode_exec_channel.write(empty_decode_bundle);
+    uop_exec_channel.write(empty_decode_bundle);
     
-    ExecutePacket empty_execute_packet;
-    empty_execute_packet.valid = false;
-    exec_writeback_channel.write(empty_execute_packet);
+    ExecuteBundle empty_execute_bundle;
+    empty_execute_bundle.count = 0;
+    exec_writeback_channel.write(empty_execute_bundle);
     
     // Connect pipeline stages
     fetchUnit->fetch_out(fetch_decode_channel);
@@ -57,23 +72,29 @@ Processor::Processor(sc_module_name name, PredictorType predictor_type) : sc_mod
     decodeUnit->decode_out(decode_exec_channel);
     executionUnit->decode_in(decode_exec_channel);
     
+    fetchUnit->uop_out(uop_exec_channel);
+    executionUnit->uop_in(uop_exec_channel);
+    
     executionUnit->execute_out(exec_writeback_channel);
     writebackUnit->execute_in(exec_writeback_channel);
     
     // Connect stall and branch signals
-    fetchUnit->stall(stall_fetch);
+    fetchUnit->stall(dispatch_stall);
     fetchUnit->branch_taken(branch_taken);
     fetchUnit->branch_target(branch_target);
     
-    decodeUnit->stall(stall_decode);
+    decodeUnit->stall(dispatch_stall);
+    decodeUnit->flush(branch_taken);
+    executionUnit->stall_out(dispatch_stall);
+    executionUnit->redirect_out(branch_taken);
+    executionUnit->redirect_target(branch_target);
     
     // Connect memory system
     fetchUnit->mem_interface(*memorySystem);
     executionUnit->mem_interface(*memorySystem);
     
     // Initialize control signals
-    stall_fetch.write(false);
-    stall_decode.write(false);
+    dispatch_stall.write(false);
     branch_taken.write(false);
     branch_target.write(0);
     
@@ -87,12 +108,24 @@ Processor::~Processor() {
     delete decodeUnit;
     delete executionUnit;
     delete writebackUnit;
+    delete uopCache;
     delete memorySystem;
     delete performanceAnalyzer;
 }
 
-void Processor::load_program(const std::string& filename) {
-    memorySystem->load_program(filename);
+bool Processor::load_program(const std::string& filename) {
+    if (!memorySystem->load_program(filename)) {
+        return false;
+    }
+    
+    // Start at the ELF entry point and profile against its symbols
+    fetchUnit->set_reset_pc(memorySystem->get_entry_point());
+    
+    // RV32 and RV64 assign some compressed encodings differently
+    fetchUnit->set_xlen(memorySystem->get_xlen());
+    decodeUnit->set_xlen(memorySystem->get_xlen());
+    performanceAnalyzer->set_symbol_table(&memorySystem->get_symbols());
+    return true;
 }
 
 void Processor::print_stats() {
@@ -138,41 +171,48 @@ void Processor::clock_proc() {
     total_cycles++;
     performanceAnalyzer->update_total_cycles(total_cycles);
     
-    // Check for completed instructions
-    ExecutePacket exec_packet = exec_writeback_channel.read();
-    if (exec_packet.valid) {
-        total_instructions++;
+    // Instructions count once they retire
+    total_instructions = executionUnit->get_retired_count();
+    
+    // Check for resolved branches
+    ExecuteBundle exec_bundle = exec_writeback_channel.read();
+    for (uint8_t i = 0; i < exec_bundle.count; i++) {
+        const ExecutePacket& exec_packet = exec_bundle.packets[i];
         performanceAnalyzer->record_instruction_writeback(exec_packet.instruction);
         
-        // If memory access, record it
-        if (exec_packet.mem_access) {
-            performanceAnalyzer->record_memory_access(!exec_packet.mem_write, exec_packet.mem_addr);
-        }
-        
-        // Track branch statistics
-        if (exec_packet.branch_taken) {
-            // Signal a branch misprediction
-            branch_taken.write(true);
-            branch_target.write(exec_packet.branch_target);
-            
-            // Notify branch predictor about the actual outcome
-            // We pass the PC to identify the branch and the actual outcome
-            fetchUnit->update_branch_prediction(exec_packet.pc, exec_packet.branch_taken);
-            
-            // Record control hazard
-            performanceAnalyzer->record_control_hazard();
-            performanceAnalyzer->record_pipeline_flush();
+        // Notify branch predictor about the actual outcome. The execution
+        // unit drives the redirect itself when the prediction was wrong.
+        fetchUnit->update_branch_prediction(exec_packet.pc, exec_packet.branch_taken);
+    }
+    
+    // Record fetch and decode stage activity (a held bundle is only counted
+    // once, when decode consumes it)
+    if (!dispatch_stall.read()) {
+        FetchBundle fetch_bundle = fetch_decode_channel.read();
+        for (uint8_t i = 0; i < fetch_bundle.count; i++) {
+            performanceAnalyzer->record_instruction_fetch(
+                expand_instruction(fetch_bundle.packets[i].instruction, memorySystem->get_xlen()));
         }
     }
     
-    // Record fetch and decode stage activity
-    FetchPacket fetch_packet = fetch_decode_channel.read();
-    if (fetch_packet.valid) {
-        performanceAnalyzer->record_instruction_fetch(fetch_packet.instruction);
+    DecodeBundle decode_bundle = decode_exec_channel.read();
+    for (uint8_t i = 0; i < decode_bundle.count; i++) {
+        performanceAnalyzer->record_instruction_decode(decode_bundle.packets[i].instruction,
+                                                      decode_bundle.packets[i].type);
+        if (decode_bundle.packets[i].fusion != FusionKind::NONE) {
+            performanceAnalyzer->record_fusion(decode_bundle.packets[i].fusion);
+        }
     }
     
-    DecodePacket decode_packet = decode_exec_channel.read();
-    if (decode_packet.valid) {
-        performanceAnalyzer->record_instruction_decode(decode_packet.instruction, decode_packet.type);
+    // Packets from the micro-op cache skip both stages but still count as
+    // delivered (and, for cached fused pairs, fused) instructions
+    DecodeBundle uop_bundle = uop_exec_channel.read();
+    for (uint8_t i = 0; i < uop_bundle.count; i++) {
+        performanceAnalyzer->record_instruction_fetch(uop_bundle.packets[i].instruction);
+        performanceAnalyzer->record_instruction_decode(uop_bundle.packets[i].instruction,
+                                                      uop_bundle.packets[i].type);
+        if (uop_bundle.packets[i].fusion != FusionKind::NONE) {
+            performanceAnalyzer->record_fusion(uop_bundle.packets[i].fusion);
+        }
     }
 }
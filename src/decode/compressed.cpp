@@ -0,0 +1,225 @@
+#include "decode/compressed.h"
+
+// 32-bit instruction encoders for the formats the expansions produce
+
+static Instruction encode_r(Opcode op, uint32_t rd, uint32_t funct3, uint32_t rs1, uint32_t rs2, uint32_t funct7) {
+    return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) |
+           static_cast<uint32_t>(op);
+}
+
+static Instruction encode_i(Opcode op, uint32_t rd, uint32_t funct3, uint32_t rs1, int32_t imm) {
+    return ((static_cast<uint32_t>(imm) & 0xFFF) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) |
+           static_cast<uint32_t>(op);
+}
+
+static Instruction encode_s(Opcode op, uint32_t funct3, uint32_t rs1, uint32_t rs2, int32_t imm) {
+    uint32_t u = static_cast<uint32_t>(imm);
+    return (((u >> 5) & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) |
+           ((u & 0x1F) << 7) | static_cast<uint32_t>(op);
+}
+
+static Instruction encode_b(uint32_t funct3, uint32_t rs1, uint32_t rs2, int32_t imm) {
+    uint32_t u = static_cast<uint32_t>(imm);
+    return (((u >> 12) & 0x1) << 31) | (((u >> 5) & 0x3F) << 25) | (rs2 << 20) | (rs1 << 15) |
+           (funct3 << 12) | (((u >> 1) & 0xF) << 8) | (((u >> 11) & 0x1) << 7) |
+           static_cast<uint32_t>(Opcode::BRANCH);
+}
+
+static Instruction encode_j(uint32_t rd, int32_t imm) {
+    uint32_t u = static_cast<uint32_t>(imm);
+    return (((u >> 20) & 0x1) << 31) | (((u >> 1) & 0x3FF) << 21) | (((u >> 11) & 0x1) << 20) |
+           (((u >> 12) & 0xFF) << 12) | (rd << 7) | static_cast<uint32_t>(Opcode::JAL);
+}
+
+// Bit field inst[hi:lo]
+static uint32_t bits(uint16_t inst, unsigned int hi, unsigned int lo) {
+    return (inst >> lo) & ((1u << (hi - lo + 1)) - 1);
+}
+
+// Sign-extend the low width bits of value
+static int32_t sign_extend(uint32_t value, unsigned int width) {
+    uint32_t shift = 32 - width;
+    return static_cast<int32_t>(value << shift) >> shift;
+}
+
+Instruction expand_compressed(uint16_t inst, unsigned int xlen) {
+    const uint32_t sp = 2;
+    const uint32_t ra = 1;
+    
+    uint32_t funct3 = bits(inst, 15, 13);
+    uint32_t rd = bits(inst, 11, 7);          // Full register fields (CR/CI/CSS)
+    uint32_t rs2 = bits(inst, 6, 2);
+    uint32_t rd_c = bits(inst, 4, 2) + 8;     // Compressed register fields (x8-x15)
+    uint32_t rs1_c = bits(inst, 9, 7) + 8;
+    
+    // 6-bit immediate of CI instructions: imm[5] = inst[12], imm[4:0] = inst[6:2]
+    int32_t ci_imm = sign_extend((bits(inst, 12, 12) << 5) | bits(inst, 6, 2), 6);
+    uint32_t shamt = (bits(inst, 12, 12) << 5) | bits(inst, 6, 2);
+    
+    // Load/store offsets scaled by the access size
+    uint32_t word_offset = (bits(inst, 12, 10) << 3) | (bits(inst, 6, 6) << 2) | (bits(inst, 5, 5) << 6);
+    uint32_t double_offset = (bits(inst, 12, 10) << 3) | (bits(inst, 6, 5) << 6);
+    
+    switch (inst & 0x3) {
+        case 0x0:
+            switch (funct3) {
+                case 0x0: {
+                    // C.ADDI4SPN: addi rd', sp, nzuimm
+                    uint32_t imm = (bits(inst, 12, 11) << 4) | (bits(inst, 10, 7) << 6) |
+                                   (bits(inst, 6, 6) << 2) | (bits(inst, 5, 5) << 3);
+                    if (imm == 0) {
+                        return 0;  // Reserved (includes the all-zero illegal instruction)
+                    }
+                    return encode_i(Opcode::OP_IMM, rd_c, 0x0, sp, imm);
+                }
+                case 0x2:
+                    // C.LW
+                    return encode_i(Opcode::LOAD, rd_c, 0x2, rs1_c, word_offset);
+                case 0x3:
+                    // C.LD (RV64; C.FLW on RV32)
+                    return xlen == 64 ? encode_i(Opcode::LOAD, rd_c, 0x3, rs1_c, double_offset) : 0;
+                case 0x6:
+                    // C.SW
+                    return encode_s(Opcode::STORE, 0x2, rs1_c, rd_c, word_offset);
+                case 0x7:
+                    // C.SD (RV64; C.FSW on RV32)
+                    return xlen == 64 ? encode_s(Opcode::STORE, 0x3, rs1_c, rd_c, double_offset) : 0;
+                default:
+                    return 0;  // Floating-point loads and stores
+            }
+        
+        case 0x1:
+            switch (funct3) {
+                case 0x0:
+                    // C.ADDI (C.NOP when rd = 0)
+                    return encode_i(Opcode::OP_IMM, rd, 0x0, rd, ci_imm);
+                case 0x1:
+                    if (xlen == 64) {
+                        // C.ADDIW
+                        return rd != 0 ? encode_i(Opcode::OP_IMM_32, rd, 0x0, rd, ci_imm) : 0;
+                    }
+                    // C.JAL (RV32): jal ra, offset
+                    break;
+                case 0x2:
+                    // C.LI: addi rd, x0, imm
+                    return encode_i(Opcode::OP_IMM, rd, 0x0, 0, ci_imm);
+                case 0x3:
+                    if (rd == sp) {
+                        // C.ADDI16SP: addi sp, sp, nzimm
+                        int32_t imm = sign_extend((bits(inst, 12, 12) << 9) | (bits(inst, 6, 6) << 4) |
+                                                  (bits(inst, 5, 5) << 6) | (bits(inst, 4, 3) << 7) |
+                                                  (bits(inst, 2, 2) << 5), 10);
+                        return imm != 0 ? encode_i(Opcode::OP_IMM, sp, 0x0, sp, imm) : 0;
+                    }
+                    // C.LUI: lui rd, nzimm
+                    if (ci_imm == 0) {
+                        return 0;
+                    }
+                    return (static_cast<uint32_t>(ci_imm) << 12) | (rd << 7) | static_cast<uint32_t>(Opcode::LUI);
+                case 0x4:
+                    switch (bits(inst, 11, 10)) {
+                        case 0x0:
+                            // C.SRLI
+                            return encode_i(Opcode::OP_IMM, rs1_c, 0x5, rs1_c, shamt);
+                        case 0x1:
+                            // C.SRAI
+                            return encode_i(Opcode::OP_IMM, rs1_c, 0x5, rs1_c, shamt | 0x400);
+                        case 0x2:
+                            // C.ANDI
+                            return encode_i(Opcode::OP_IMM, rs1_c, 0x7, rs1_c, ci_imm);
+                        default:
+                            break;
+                    }
+                    
+                    if (bits(inst, 12, 12) == 0) {
+                        // C.SUB, C.XOR, C.OR, C.AND
+                        switch (bits(inst, 6, 5)) {
+                            case 0x0: return encode_r(Opcode::OP, rs1_c, 0x0, rs1_c, rd_c, 0x20);
+                            case 0x1: return encode_r(Opcode::OP, rs1_c, 0x4, rs1_c, rd_c, 0x00);
+                            case 0x2: return encode_r(Opcode::OP, rs1_c, 0x6, rs1_c, rd_c, 0x00);
+                            default:  return encode_r(Opcode::OP, rs1_c, 0x7, rs1_c, rd_c, 0x00);
+                        }
+                    }
+                    
+                    // C.SUBW and C.ADDW (RV64)
+                    if (xlen == 64 && bits(inst, 6, 5) == 0x0) {
+                        return encode_r(Opcode::OP_32, rs1_c, 0x0, rs1_c, rd_c, 0x20);
+                    }
+                    if (xlen == 64 && bits(inst, 6, 5) == 0x1) {
+                        return encode_r(Opcode::OP_32, rs1_c, 0x0, rs1_c, rd_c, 0x00);
+                    }
+                    return 0;
+                case 0x5:
+                    // C.J: jal x0, offset
+                    break;
+                case 0x6:
+                case 0x7: {
+                    // C.BEQZ / C.BNEZ: beq/bne rs1', x0, offset
+                    int32_t imm = sign_extend((bits(inst, 12, 12) << 8) | (bits(inst, 11, 10) << 3) |
+                                              (bits(inst, 6, 5) << 6) | (bits(inst, 4, 3) << 1) |
+                                              (bits(inst, 2, 2) << 5), 9);
+                    return encode_b(funct3 == 0x6 ? 0x0 : 0x1, rs1_c, 0, imm);
+                }
+            }
+            
+            // C.J and C.JAL share the CJ offset layout
+            {
+                int32_t imm = sign_extend((bits(inst, 12, 12) << 11) | (bits(inst, 11, 11) << 4) |
+                                          (bits(inst, 10, 9) << 8) | (bits(inst, 8, 8) << 10) |
+                                          (bits(inst, 7, 7) << 6) | (bits(inst, 6, 6) << 7) |
+                                          (bits(inst, 5, 3) << 1) | (bits(inst, 2, 2) << 5), 12);
+                return encode_j(funct3 == 0x1 ? ra : 0, imm);
+            }
+        
+        case 0x2:
+            switch (funct3) {
+                case 0x0:
+                    // C.SLLI
+                    return encode_i(Opcode::OP_IMM, rd, 0x1, rd, shamt);
+                case 0x2: {
+                    // C.LWSP
+                    uint32_t imm = (bits(inst, 12, 12) << 5) | (bits(inst, 6, 4) << 2) | (bits(inst, 3, 2) << 6);
+                    return rd != 0 ? encode_i(Opcode::LOAD, rd, 0x2, sp, imm) : 0;
+                }
+                case 0x3: {
+                    // C.LDSP (RV64; C.FLWSP on RV32)
+                    uint32_t imm = (bits(inst, 12, 12) << 5) | (bits(inst, 6, 5) << 3) | (bits(inst, 4, 2) << 6);
+                    return (xlen == 64 && rd != 0) ? encode_i(Opcode::LOAD, rd, 0x3, sp, imm) : 0;
+                }
+                case 0x4:
+                    if (bits(inst, 12, 12) == 0) {
+                        if (rs2 == 0) {
+                            // C.JR: jalr x0, 0(rs1)
+                            return rd != 0 ? encode_i(Opcode::JALR, 0, 0x0, rd, 0) : 0;
+                        }
+                        // C.MV: add rd, x0, rs2
+                        return encode_r(Opcode::OP, rd, 0x0, 0, rs2, 0x00);
+                    }
+                    if (rs2 == 0) {
+                        if (rd == 0) {
+                            // C.EBREAK
+                            return 0x00100073;
+                        }
+                        // C.JALR: jalr ra, 0(rs1)
+                        return encode_i(Opcode::JALR, ra, 0x0, rd, 0);
+                    }
+                    // C.ADD: add rd, rd, rs2
+                    return encode_r(Opcode::OP, rd, 0x0, rd, rs2, 0x00);
+                case 0x6: {
+                    // C.SWSP
+                    uint32_t imm = (bits(inst, 12, 9) << 2) | (bits(inst, 8, 7) << 6);
+                    return encode_s(Opcode::STORE, 0x2, sp, rs2, imm);
+                }
+                case 0x7: {
+                    // C.SDSP (RV64; C.FSWSP on RV32)
+                    uint32_t imm = (bits(inst, 12, 10) << 3) | (bits(inst, 9, 7) << 6);
+                    return xlen == 64 ? encode_s(Opcode::STORE, 0x3, sp, rs2, imm) : 0;
+                }
+                default:
+                    return 0;  // Floating-point stack loads and stores
+            }
+        
+        default:
+            return 0;  // Not a compressed encoding
+    }
+}
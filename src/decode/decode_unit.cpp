@@ -1,6 +1,8 @@
 #include "decode/decode_unit.h"
+#include "decode/compressed.h"
 
-DecodeUnit::DecodeUnit(sc_module_name name) : sc_module(name) {
+DecodeUnit::DecodeUnit(sc_module_name name, bool fusion)
+    : sc_module(name), xlen(64), fusion_enabled(fusion), uop_cache(nullptr) {
     // Register process
     SC_METHOD(decode_proc);
     sensitive << clk.pos();
@@ -11,41 +13,184 @@ DecodeUnit::DecodeUnit(sc_module_name name) : sc_module(name) {
 
 void DecodeUnit::decode_proc() {
     if (reset.read()) {
-        // Reset output to invalid packet
-        DecodePacket empty_packet;
-        empty_packet.valid = false;
-        decode_out.write(empty_packet);
+        // Reset output to an empty bundle
+        DecodeBundle empty_bundle;
+        empty_bundle.count = 0;
+        decode_out.write(empty_bundle);
+    } else if (flush.read()) {
+        // The bundle at our input was fetched down the mispredicted path
+        DecodeBundle empty_bundle;
+        empty_bundle.count = 0;
+        decode_out.write(empty_bundle);
     } else if (!stall.read()) {
-        // Get fetch packet
-        FetchPacket fetch_packet = fetch_in.read();
-        
-        if (fetch_packet.valid) {
-            // Decode the instruction
-            Instruction inst = fetch_packet.instruction;
-            
-            // Create decode packet
-            DecodePacket packet;
-            packet.instruction = inst;
-            packet.pc = fetch_packet.pc;
-            packet.type = get_instruction_type(inst);
-            packet.opcode = get_opcode(inst);
-            packet.funct3 = get_funct3(inst);
-            packet.funct7 = get_funct7(inst);
-            packet.rd = get_rd(inst);
-            packet.rs1 = get_rs1(inst);
-            packet.rs2 = get_rs2(inst);
-            packet.imm = get_immediate(inst, packet.type);
-            packet.valid = true;
-            
-            // Write output
-            decode_out.write(packet);
-        } else {
-            // Propagate invalid packet
-            DecodePacket empty_packet;
-            empty_packet.valid = false;
-            decode_out.write(empty_packet);
+        // Get fetch bundle
+        FetchBundle fetch_bundle = fetch_in.read();
+        
+        // Decode every valid instruction in the group
+        DecodeBundle bundle;
+        bundle.count = 0;
+        
+        for (uint8_t i = 0; i < fetch_bundle.count; i++) {
+            if (fetch_bundle.packets[i].valid) {
+                bundle.packets[bundle.count++] = decode_instruction(fetch_bundle.packets[i]);
+            }
+        }
+        
+        // Fuse adjacent pairs within the group, each into a single op
+        if (fusion_enabled) {
+            uint8_t fused_count = 0;
+            for (uint8_t i = 0; i < bundle.count; i++) {
+                if (i + 1 < bundle.count &&
+                    fuse(bundle.packets[i], bundle.packets[i + 1], bundle.packets[fused_count])) {
+                    i++;
+                } else {
+                    bundle.packets[fused_count] = bundle.packets[i];
+                }
+                fused_count++;
+            }
+            bundle.count = fused_count;
+        }
+        
+        // A fetch group is one fetch block; keep its packets for the next
+        // time fetch reaches it
+        if (uop_cache && bundle.count > 0) {
+            const FetchPacket &last = fetch_bundle.packets[fetch_bundle.count - 1];
+            uop_cache->insert(fetch_bundle.packets[0].pc, last.pc + instruction_length(last.instruction), bundle);
         }
+        
+        // Write output (an empty bundle propagates a bubble)
+        decode_out.write(bundle);
+    } else {
+        // While dispatch is stalled the fetch bundle is held at our input;
+        // emit a bubble so the bundle we already delivered is not seen twice
+        DecodeBundle empty_bundle;
+        empty_bundle.count = 0;
+        decode_out.write(empty_bundle);
+    }
+}
+
+DecodePacket DecodeUnit::decode_instruction(const FetchPacket& fetch_packet) {
+    // Compressed instructions are expanded to their 32-bit equivalents and
+    // decoded like any other
+    Instruction inst = expand_instruction(fetch_packet.instruction, xlen);
+    
+    // Create decode packet
+    DecodePacket packet;
+    packet.instruction = inst;
+    packet.pc = fetch_packet.pc;
+    packet.length = instruction_length(fetch_packet.instruction);
+    packet.type = get_instruction_type(inst);
+    packet.opcode = get_opcode(inst);
+    packet.funct3 = get_funct3(inst);
+    packet.funct7 = get_funct7(inst);
+    packet.rd = get_rd(inst);
+    packet.rs1 = get_rs1(inst);
+    packet.rs2 = get_rs2(inst);
+    packet.imm = get_immediate(inst, packet.type);
+    packet.predicted_pc = fetch_packet.predicted_pc;
+    packet.fusion = FusionKind::NONE;
+    packet.imm2 = 0;
+    packet.valid = true;
+    
+    return packet;
+}
+
+bool DecodeUnit::fuse(const DecodePacket& first, const DecodePacket& second, DecodePacket& fused) {
+    // Only back-to-back instructions, where the second consumes the first's
+    // result and overwrites it (so only one value needs to be produced)
+    uint8_t rd = first.rd;
+    if (rd == 0 || second.pc != first.pc + first.length) {
+        return false;
+    }
+    
+    // The fused op takes the second instruction's place: its PC, length and
+    // predicted successor. PC-relative offsets are rebased accordingly.
+    DecodePacket op = second;
+    int64_t first_offset = -static_cast<int64_t>(first.length);
+    int64_t imm;
+    
+    switch (first.opcode) {
+        case Opcode::LUI:
+            // lui rd, hi; addi/addiw rd, rd, lo
+            if (second.rd != rd || second.rs1 != rd || second.funct3 != Funct3::ADD) {
+                return false;
+            }
+            if (second.opcode == Opcode::OP_IMM) {
+                imm = static_cast<int64_t>(first.imm) + second.imm;
+            } else if (second.opcode == Opcode::OP_IMM_32) {
+                imm = static_cast<int32_t>(static_cast<uint32_t>(first.imm) + static_cast<uint32_t>(second.imm));
+            } else {
+                return false;
+            }
+            if (imm < INT32_MIN || imm > INT32_MAX) {
+                return false;
+            }
+            op = first;
+            op.pc = second.pc;
+            op.length = second.length;
+            op.predicted_pc = second.predicted_pc;
+            op.imm = static_cast<int32_t>(imm);
+            op.fusion = FusionKind::LOAD_IMMEDIATE;
+            break;
+        
+        case Opcode::AUIPC:
+            imm = first_offset + first.imm + second.imm;
+            if (imm < INT32_MIN || imm > INT32_MAX || second.rs1 != rd || second.rd != rd) {
+                return false;
+            }
+            if (second.opcode == Opcode::OP_IMM && second.funct3 == Funct3::ADD) {
+                // auipc rd, hi; addi rd, rd, lo
+                op = first;
+                op.pc = second.pc;
+                op.length = second.length;
+                op.predicted_pc = second.predicted_pc;
+                op.fusion = FusionKind::PC_RELATIVE;
+            } else if (second.opcode == Opcode::JALR && (second.imm & 1) == 0) {
+                // auipc ra, hi; jalr ra, lo(ra): a direct call (JALR would
+                // clear bit 0 of the target, so odd offsets are left alone)
+                op.opcode = Opcode::JAL;
+                op.type = InstructionType::J_TYPE;
+                op.fusion = FusionKind::CALL;
+            } else {
+                return false;
+            }
+            op.imm = static_cast<int32_t>(imm);
+            break;
+        
+        case Opcode::OP_IMM:
+            // slli rd, rs, a; srli/srai rd, rd, b
+            if (first.funct3 != Funct3::SLL || second.opcode != Opcode::OP_IMM ||
+                second.funct3 != Funct3::SRL || second.rd != rd || second.rs1 != rd) {
+                return false;
+            }
+            op = second;
+            op.rs1 = first.rs1;
+            op.imm = first.imm & 0x3F;
+            op.imm2 = second.imm & 0x3F;
+            op.fusion = FusionKind::SHIFT_EXTEND;
+            break;
+        
+        case Opcode::OP:
+            // slt/sltu rd, rs1, rs2; beqz/bnez rd, target
+            if ((first.funct3 != Funct3::SLT && first.funct3 != Funct3::SLTU) || first.funct7 != 0 ||
+                second.opcode != Opcode::BRANCH ||
+                (second.funct3 != Funct3::BEQ && second.funct3 != Funct3::BNE) ||
+                !((second.rs1 == rd && second.rs2 == 0) || (second.rs1 == 0 && second.rs2 == rd))) {
+                return false;
+            }
+            op.rd = rd;
+            op.rs1 = first.rs1;
+            op.rs2 = first.rs2;
+            op.imm2 = static_cast<int32_t>(first.funct3);
+            op.fusion = FusionKind::COMPARE_BRANCH;
+            break;
+        
+        default:
+            return false;
     }
+    
+    fused = op;
+    return true;
 }
 
 InstructionType DecodeUnit::get_instruction_type(Instruction inst) {
@@ -53,26 +198,28 @@ InstructionType DecodeUnit::get_instruction_type(Instruction inst) {
     
     switch (opcode) {
         case static_cast<uint32_t>(Opcode::OP):
+        case static_cast<uint32_t>(Opcode::OP_32):
             return InstructionType::R_TYPE;
-            
+        
         case static_cast<uint32_t>(Opcode::OP_IMM):
+        case static_cast<uint32_t>(Opcode::OP_IMM_32):
         case static_cast<uint32_t>(Opcode::LOAD):
         case static_cast<uint32_t>(Opcode::JALR):
             return InstructionType::I_TYPE;
-            
+        
         case static_cast<uint32_t>(Opcode::STORE):
             return InstructionType::S_TYPE;
-            
+        
         case static_cast<uint32_t>(Opcode::BRANCH):
             return InstructionType::B_TYPE;
-            
+        
         case static_cast<uint32_t>(Opcode::LUI):
         case static_cast<uint32_t>(Opcode::AUIPC):
             return InstructionType::U_TYPE;
-            
+        
         case static_cast<uint32_t>(Opcode::JAL):
             return InstructionType::J_TYPE;
-            
+        
         default:
             return InstructionType::UNKNOWN;
     }
@@ -92,6 +239,8 @@ Opcode DecodeUnit::get_opcode(Instruction inst) {
         case 0b0010011: return Opcode::OP_IMM;
         case 0b0110011: return Opcode::OP;
         case 0b1110011: return Opcode::SYSTEM;
+        case 0b0011011: return Opcode::OP_IMM_32;
+        case 0b0111011: return Opcode::OP_32;
         default: return Opcode::UNKNOWN;
     }
 }
@@ -127,7 +276,7 @@ int32_t DecodeUnit::get_immediate(Instruction inst, InstructionType type) {
             // Sign extend
             if (imm & 0x800) imm |= 0xFFFFF000;
             break;
-            
+        
         case InstructionType::S_TYPE:
             // S-type: imm[11:5] = inst[31:25], imm[4:0] = inst[11:7]
             imm = ((inst >> 25) & 0x7F) << 5;
@@ -135,7 +284,7 @@ int32_t DecodeUnit::get_immediate(Instruction inst, InstructionType type) {
             // Sign extend
             if (imm & 0x800) imm |= 0xFFFFF000;
             break;
-            
+        
         case InstructionType::B_TYPE:
             // B-type: imm[12] = inst[31], imm[10:5] = inst[30:25], imm[4:1] = inst[11:8], imm[11] = inst[7]
             imm = ((inst >> 31) & 0x1) << 12;
@@ -145,12 +294,12 @@ int32_t DecodeUnit::get_immediate(Instruction inst, InstructionType type) {
             // Sign extend
             if (imm & 0x1000) imm |= 0xFFFFE000;
             break;
-            
+        
         case InstructionType::U_TYPE:
             // U-type: imm[31:12] = inst[31:12]
             imm = inst & 0xFFFFF000;
             break;
-            
+        
         case InstructionType::J_TYPE:
             // J-type: imm[20] = inst[31], imm[10:1] = inst[30:21], imm[11] = inst[20], imm[19:12] = inst[19:12]
             imm = ((inst >> 31) & 0x1) << 20;
@@ -160,7 +309,7 @@ int32_t DecodeUnit::get_immediate(Instruction inst, InstructionType type) {
             // Sign extend
             if (imm & 0x100000) imm |= 0xFFF00000;
             break;
-            
+        
         default:
             imm = 0;
             break;
@@ -2,15 +2,188 @@
 #include "execute/reservation_station.h"
 #include "execute/reorder_buffer.h"
 #include "execute/register_file.h"
+#include "execute/rename_unit.h"
+#include "execute/functional_unit.h"
+#include "execute/load_store_queue.h"
+#include "execute/store_set_predictor.h"
+#include "execute/load_value_predictor.h"
+#include "execute/store_buffer.h"
+#include <algorithm>
+#include <climits>
+#include <set>
 
-ExecutionUnit::ExecutionUnit(sc_module_name name) : sc_module(name) {
+// Whether an instruction writes its rd field (a fused compare-and-branch
+// keeps the compare's destination)
+static bool writes_register(Opcode opcode, uint8_t rd, FusionKind fusion) {
+    if (fusion == FusionKind::COMPARE_BRANCH) {
+        return rd != 0;
+    }
+    return rd != 0 && opcode != Opcode::STORE && opcode != Opcode::BRANCH;
+}
+
+// Bytes accessed by a load or store
+static uint8_t access_size(Funct3 funct3) {
+    switch (funct3) {
+        case Funct3::LB:
+        case Funct3::LBU:
+            return 1;
+        case Funct3::LH:
+        case Funct3::LHU:
+            return 2;
+        case Funct3::LD:
+            return 8;
+        default:
+            return 4;
+    }
+}
+
+// M extension multiply, divide and remainder. Word forms operate on the low
+// 32 bits and sign-extend the result. Division by zero and signed overflow
+// return the values the ISA defines instead of trapping.
+static RegisterValue multiply_divide(bool word, Funct3 funct3, RegisterValue op1, RegisterValue op2) {
+    if (word) {
+        int32_t a = static_cast<int32_t>(op1);
+        int32_t b = static_cast<int32_t>(op2);
+        uint32_t ua = static_cast<uint32_t>(op1);
+        uint32_t ub = static_cast<uint32_t>(op2);
+        uint32_t r = 0;
+        switch (funct3) {
+            case Funct3::MUL:
+                r = ua * ub;
+                break;
+            case Funct3::DIV:
+                r = (b == 0) ? 0xFFFFFFFFu :
+                    (a == INT32_MIN && b == -1) ? ua : static_cast<uint32_t>(a / b);
+                break;
+            case Funct3::DIVU:
+                r = (ub == 0) ? 0xFFFFFFFFu : ua / ub;
+                break;
+            case Funct3::REM:
+                r = (b == 0) ? ua :
+                    (a == INT32_MIN && b == -1) ? 0 : static_cast<uint32_t>(a % b);
+                break;
+            case Funct3::REMU:
+                r = (ub == 0) ? ua : ua % ub;
+                break;
+            default:
+                break;  // No word forms of the high multiplies
+        }
+        return static_cast<RegisterValue>(static_cast<int64_t>(static_cast<int32_t>(r)));
+    }
+    
+    int64_t a = static_cast<int64_t>(op1);
+    int64_t b = static_cast<int64_t>(op2);
+    switch (funct3) {
+        case Funct3::MUL:
+            return op1 * op2;
+        case Funct3::MULH:
+            return static_cast<RegisterValue>((static_cast<__int128>(a) * b) >> 64);
+        case Funct3::MULHSU:
+            return static_cast<RegisterValue>((static_cast<__int128>(a) * static_cast<__int128>(op2)) >> 64);
+        case Funct3::MULHU:
+            return static_cast<RegisterValue>((static_cast<unsigned __int128>(op1) * op2) >> 64);
+        case Funct3::DIV:
+            if (b == 0) return ~RegisterValue(0);
+            if (a == INT64_MIN && b == -1) return op1;
+            return static_cast<RegisterValue>(a / b);
+        case Funct3::DIVU:
+            return (op2 == 0) ? ~RegisterValue(0) : op1 / op2;
+        case Funct3::REM:
+            if (b == 0) return op1;
+            if (a == INT64_MIN && b == -1) return 0;
+            return static_cast<RegisterValue>(a % b);
+        case Funct3::REMU:
+            return (op2 == 0) ? op1 : op1 % op2;
+        default:
+            return 0;
+    }
+}
+
+// Moves and zero idioms that rename can resolve without executing
+static EliminationKind classify_elimination(const DecodePacket& packet) {
+    if (packet.rd == 0 || packet.fusion != FusionKind::NONE) {
+        return EliminationKind::NONE;
+    }
+    
+    if (packet.opcode == Opcode::OP_IMM && packet.funct3 == Funct3::ADD) {
+        if (packet.rs1 == 0) {
+            return EliminationKind::ZERO_IDIOM;   // li rd, imm
+        }
+        if (packet.imm == 0) {
+            return EliminationKind::MOVE;         // mv rd, rs
+        }
+    }
+    
+    if (packet.opcode == Opcode::OP) {
+        bool sub = (packet.funct3 == Funct3::ADD && packet.funct7 == 0x20);
+        if ((sub || (packet.funct3 == Funct3::XOR && packet.funct7 == 0)) && packet.rs1 == packet.rs2) {
+            return EliminationKind::ZERO_IDIOM;   // xor/sub rd, rs, rs
+        }
+        if (packet.funct3 == Funct3::ADD && packet.funct7 == 0 &&
+            (packet.rs1 == 0) != (packet.rs2 == 0)) {
+            return EliminationKind::MOVE;         // add rd, x0, rs (C.MV)
+        }
+    }
+    
+    return EliminationKind::NONE;
+}
+
+// Whether an instruction can redirect fetch
+static bool is_control_op(Opcode opcode) {
+    return opcode == Opcode::BRANCH || opcode == Opcode::JAL || opcode == Opcode::JALR;
+}
+
+ExecutionUnit::ExecutionUnit(sc_module_name name, const ProcessorConfig& config)
+    : sc_module(name),
+      dispatch_width(config.pipeline_width),
+      instruction_queue_size(config.instruction_queue_size),
+      commit_width(config.commit_width),
+      rename_mode(config.rename_mode),
+      select_policy(config.select_policy),
+      mem_dep_policy(config.mem_dep_policy),
+      eliminate_at_rename(config.rename_elimination),
+      dcache_latency(config.l1d.hit_latency),
+      perf(nullptr),
+      retired_count(0) {
+    // Clamp the dispatch width to what the decode/dispatch channel can carry
+    if (dispatch_width == 0) dispatch_width = 1;
+    if (dispatch_width > MAX_PIPELINE_WIDTH) dispatch_width = MAX_PIPELINE_WIDTH;
+    if (commit_width == 0) commit_width = 1;
+    
+    // The micro-op cache may deliver wider groups than decode
+    bundle_width = dispatch_width;
+    if (config.uop_cache.entries > 0) {
+        bundle_width = std::max(bundle_width, std::min(config.uop_cache.width, MAX_PIPELINE_WIDTH));
+    }
+    
+    // The queue must absorb the bundle already in flight when we raise a stall
+    if (instruction_queue_size < 2 * bundle_width) {
+        instruction_queue_size = 2 * bundle_width;
+    }
+    
     // Create components
     rs_alu = new ReservationStation("rs_alu", 8);      // 8 entries for ALU operations
     rs_mem = new ReservationStation("rs_mem", 4);      // 4 entries for memory operations
     rs_branch = new ReservationStation("rs_branch", 2); // 2 entries for branch operations
-    rob = new ReorderBuffer("rob", 16);                // 16 entries in reorder buffer
+    rob = new ReorderBuffer("rob", config.rob_size);   // 16 entries in reorder buffer by default
     regfile = new RegisterFile("regfile", 32);         // 32 registers in RISC-V
     
+    // Physical registers back every architectural register plus the rename pool
+    rename = new RenameUnit("rename", 32, config.num_phys_regs, config.rat_checkpoints);
+    prf = new RegisterFile("prf", std::max(config.num_phys_regs, 33u));
+    
+    fu_pool = new FunctionalUnitPool("fu_pool", config);
+    lsq = new LoadStoreQueue("lsq", config.load_queue_size, config.store_queue_size);
+    store_sets = new StoreSetPredictor("store_sets", config.ssit_size, config.lfst_size);
+    value_predictor = nullptr;
+    if (config.value_prediction) {
+        value_predictor = new LoadValuePredictor("value_predictor", config.lvp_entries, config.lvp_confidence);
+    }
+    store_buffer = new StoreBuffer("store_buffer", config.store_buffer_size, config.l1d.line_size,
+                                   config.store_buffer_drain_interval);
+    
+    refilling = false;
+    
     // Initialize register status table
     reg_status.resize(32);
     for (int i = 0; i < 32; i++) {
@@ -41,6 +214,13 @@ ExecutionUnit::~ExecutionUnit() {
     delete rs_branch;
     delete rob;
     delete regfile;
+    delete rename;
+    delete prf;
+    delete fu_pool;
+    delete lsq;
+    delete store_sets;
+    delete value_predictor;
+    delete store_buffer;
 }
 
 void ExecutionUnit::issue_proc() {
@@ -50,6 +230,14 @@ void ExecutionUnit::issue_proc() {
         rs_mem->reset();
         rs_branch->reset();
         rob->reset();
+        rename->reset();
+        prf->reset();
+        lsq->reset();
+        store_sets->reset();
+        store_buffer->reset();
+        if (value_predictor) {
+            value_predictor->reset();
+        }
         
         // Reset register status
         for (auto &status : reg_status) {
@@ -57,54 +245,161 @@ void ExecutionUnit::issue_proc() {
             status.rob_entry = 0;
         }
         
+        instruction_queue.clear();
+        refilling = false;
+        stall_out.write(false);
+        
         return;
     }
     
-    // Get the decode packet
-    DecodePacket decode_packet = decode_in.read();
+    // Accept the bundle decoded last cycle and the micro-op cache delivery
+    // that followed it, unless we redirected fetch last cycle, in which case
+    // both came from the wrong path
+    DecodeBundle bundle = decode_in.read();
+    DecodeBundle uops = uop_in.read();
+    if (!redirect_out.read()) {
+        for (uint8_t i = 0; i < bundle.count; i++) {
+            if (bundle.packets[i].valid) {
+                instruction_queue.push_back(bundle.packets[i]);
+            }
+        }
+        for (uint8_t i = 0; i < uops.count; i++) {
+            if (uops.packets[i].valid) {
+                instruction_queue.push_back(uops.packets[i]);
+            }
+        }
+    }
+    
+    // Rename and allocate up to dispatch_width instructions in program order.
+    // Each instruction updates reg_status before the next one reads it, so a
+    // consumer later in the group picks up its producer's ROB tag. Dispatch
+    // stops at the first instruction that cannot get its resources; the rest
+    // of the group stays queued for the next cycle.
+    unsigned int dispatched = 0;
+    bool blocked = false;
+    DispatchStall reason = DispatchStall::ROB_FULL;
+    while (dispatched < dispatch_width && !instruction_queue.empty()) {
+        if (!dispatch_instruction(instruction_queue.front(), reason)) {
+            if (perf) {
+                perf->record_structural_hazard(reason);
+            }
+            blocked = true;
+            break;
+        }
+        
+        instruction_queue.pop_front();
+        dispatched++;
+    }
     
-    if (!decode_packet.valid) {
-        return;
+    if (perf) {
+        perf->record_dispatch(dispatched);
+        
+        // Slots left empty are the backend's fault if dispatch was blocked,
+        // else the front end's, or bad speculation while fetch refills
+        SlotLoss lost = SlotLoss::FRONTEND;
+        if (blocked) {
+            lost = classify_backend_stall(reason);
+        } else if (refilling) {
+            lost = SlotLoss::RECOVERY;
+        }
+        perf->record_dispatch_slots(dispatched, dispatch_width, lost);
+        
+        if (rename_mode == RenameMode::MERGED) {
+            perf->record_register_occupancy(rename->allocated_count(), prf->size());
+        }
     }
     
+    if (dispatched > 0) {
+        refilling = false;
+    }
+    
+    // The stall reaches the front end next cycle, by which time one more
+    // bundle is already on its way, so keep room for two bundles
+    stall_out.write(instruction_queue.size() + 2 * bundle_width > instruction_queue_size);
+}
+
+bool ExecutionUnit::dispatch_instruction(const DecodePacket& decode_packet, DispatchStall& reason) {
     // Check if ROB is full
     if (rob->is_full()) {
-        return;
+        reason = DispatchStall::ROB_FULL;
+        return false;
     }
     
     // Determine which reservation station to use
     ReservationStation* rs = nullptr;
-    bool is_memory_op = false;
-    bool is_branch_op = false;
     
     switch (decode_packet.opcode) {
         case Opcode::LOAD:
         case Opcode::STORE:
             rs = rs_mem;
-            is_memory_op = true;
+            reason = DispatchStall::RS_MEM_FULL;
             break;
-            
+        
         case Opcode::BRANCH:
         case Opcode::JAL:
         case Opcode::JALR:
             rs = rs_branch;
-            is_branch_op = true;
+            reason = DispatchStall::RS_BRANCH_FULL;
             break;
-            
+        
         default:
             rs = rs_alu;
+            reason = DispatchStall::RS_ALU_FULL;
             break;
     }
     
+    // Moves and zero idioms only need a ROB entry and a destination register
+    EliminationKind elimination = eliminate_at_rename ? classify_elimination(decode_packet) : EliminationKind::NONE;
+    
     // Check if reservation station is full
-    if (rs->is_full()) {
-        return;
+    if (elimination == EliminationKind::NONE && rs->is_full()) {
+        return false;
+    }
+    
+    // Loads and stores also need a load/store queue entry
+    if (decode_packet.opcode == Opcode::LOAD && lsq->is_load_queue_full()) {
+        reason = DispatchStall::LQ_FULL;
+        return false;
+    }
+    if (decode_packet.opcode == Opcode::STORE && lsq->is_store_queue_full()) {
+        reason = DispatchStall::SQ_FULL;
+        return false;
+    }
+    
+    // Merged renaming needs a free physical register for the destination and
+    // a checkpoint of the alias table for anything that can redirect fetch
+    bool has_dest = writes_register(decode_packet.opcode, decode_packet.rd, decode_packet.fusion);
+    bool is_control = is_control_op(decode_packet.opcode);
+    
+    if (rename_mode == RenameMode::MERGED) {
+        if (has_dest && !rename->has_free_register()) {
+            reason = DispatchStall::FREE_LIST_EMPTY;
+            return false;
+        }
+        
+        if (is_control && !rename->has_free_checkpoint()) {
+            reason = DispatchStall::CHECKPOINTS_FULL;
+            return false;
+        }
     }
     
     // Allocate ROB entry
     int rob_index = rob->allocate_entry();
     if (rob_index < 0) {
-        return; // ROB allocation failed
+        reason = DispatchStall::ROB_FULL;
+        return false; // ROB allocation failed
+    }
+    
+    // Memory operations enter the load/store queue in program order, each
+    // waiting for the last store of its predicted store set
+    bool use_store_sets = (mem_dep_policy == MemDepPolicy::STORE_SETS);
+    if (decode_packet.opcode == Opcode::LOAD) {
+        lsq->allocate_load(rob_index, use_store_sets ? store_sets->predict(decode_packet.pc) : 0);
+    } else if (decode_packet.opcode == Opcode::STORE) {
+        uint64_t seq = lsq->allocate_store(rob_index, use_store_sets ? store_sets->predict(decode_packet.pc) : 0);
+        if (use_store_sets) {
+            store_sets->store_dispatched(decode_packet.pc, seq);
+        }
     }
     
     // Initialize ROB entry
@@ -117,8 +412,24 @@ void ExecutionUnit::issue_proc() {
     rob_entry.mem_addr = 0;
     rob_entry.mem_data = 0;
     rob_entry.pc = decode_packet.pc;
+    rob_entry.opcode = decode_packet.opcode;
+    rob_entry.funct3 = decode_packet.funct3;
+    rob_entry.predicted_pc = decode_packet.predicted_pc;
+    rob_entry.phys_dest = -1;
+    rob_entry.old_phys_dest = -1;
+    rob_entry.checkpoint = -1;
+    rob_entry.fusion = decode_packet.fusion;
+    rob_entry.move_tag = 0;
+    rob_entry.value_predicted = false;
+    rob_entry.predicted_value = 0;
     
-    rob->update_entry(rob_index, rob_entry);
+    // A confident load hands its predicted value to consumers renamed after it
+    if (value_predictor && decode_packet.opcode == Opcode::LOAD && has_dest) {
+        rob_entry.value_predicted = value_predictor->predict(decode_packet.pc, rob_entry.predicted_value);
+        if (perf) {
+            perf->record_value_lookup(rob_entry.value_predicted);
+        }
+    }
     
     // Create reservation station entry
     RSEntry rs_entry;
@@ -129,31 +440,16 @@ void ExecutionUnit::issue_proc() {
     rs_entry.rd = decode_packet.rd;
     rs_entry.imm = decode_packet.imm;
     rs_entry.pc = decode_packet.pc;
-    rs_entry.ready = true; // Initially set to true, will be updated below
+    rs_entry.length = decode_packet.length;
+    rs_entry.fusion = decode_packet.fusion;
+    rs_entry.imm2 = decode_packet.imm2;
     
     // Check operand availability
     // For RS1
     if (decode_packet.rs1 != 0 && 
         decode_packet.type != InstructionType::U_TYPE && 
         decode_packet.type != InstructionType::J_TYPE) {
-        
-        if (reg_status[decode_packet.rs1].busy) {
-            // RS1 is waiting for a result
-            int wait_rob = reg_status[decode_packet.rs1].rob_entry;
-            if (rob->is_entry_completed(wait_rob)) {
-                // Result is available in ROB
-                rs_entry.Vj = rob->get_entry_value(wait_rob);
-                rs_entry.Qj = 0;
-            } else {
-                // Result is not yet available
-                rs_entry.Qj = wait_rob + 1; // +1 to avoid 0, which means "available"
-                rs_entry.ready = false;
-            }
-        } else {
-            // RS1 is available in register file
-            rs_entry.Vj = regfile->read(decode_packet.rs1);
-            rs_entry.Qj = 0;
-        }
+        read_operand(decode_packet.rs1, rs_entry.Vj, rs_entry.Qj);
     } else {
         rs_entry.Vj = 0;
         rs_entry.Qj = 0;
@@ -164,100 +460,414 @@ void ExecutionUnit::issue_proc() {
         (decode_packet.type == InstructionType::R_TYPE || 
          decode_packet.type == InstructionType::S_TYPE || 
          decode_packet.type == InstructionType::B_TYPE)) {
-        
-        if (reg_status[decode_packet.rs2].busy) {
-            // RS2 is waiting for a result
-            int wait_rob = reg_status[decode_packet.rs2].rob_entry;
-            if (rob->is_entry_completed(wait_rob)) {
-                // Result is available in ROB
-                rs_entry.Vk = rob->get_entry_value(wait_rob);
-                rs_entry.Qk = 0;
-            } else {
-                // Result is not yet available
-                rs_entry.Qk = wait_rob + 1; // +1 to avoid 0, which means "available"
-                rs_entry.ready = false;
-            }
-        } else {
-            // RS2 is available in register file
-            rs_entry.Vk = regfile->read(decode_packet.rs2);
-            rs_entry.Qk = 0;
-        }
+        read_operand(decode_packet.rs2, rs_entry.Vk, rs_entry.Qk);
     } else {
         rs_entry.Vk = 0;
         rs_entry.Qk = 0;
     }
     
-    // Add entry to reservation station
-    rs->add_entry(rs_entry, rob_index);
+    rs_entry.ready = (rs_entry.Qj == 0 && rs_entry.Qk == 0);
     
-    // Update register status for destination register (except for stores and branches)
-    if (decode_packet.rd != 0 && 
-        decode_packet.opcode != Opcode::STORE && 
-        decode_packet.opcode != Opcode::BRANCH) {
-        
-        reg_status[decode_packet.rd].busy = true;
-        reg_status[decode_packet.rd].rob_entry = rob_index;
+    // A source still in flight is a read-after-write dependence
+    if (perf && !rs_entry.ready) {
+        perf->record_data_hazard();
+    }
+    
+    // Add entry to reservation station (eliminated instructions never issue;
+    // a move whose source is still in flight waits on the source's tag)
+    if (elimination == EliminationKind::NONE) {
+        rs->add_entry(rs_entry, rob_index);
+    } else if (elimination == EliminationKind::MOVE) {
+        rob_entry.move_tag = (rs_entry.Qj != 0) ? rs_entry.Qj : rs_entry.Qk;
+    }
+    
+    // Rename the destination register (except for stores and branches)
+    if (has_dest) {
+        if (rename_mode == RenameMode::MERGED) {
+            rob_entry.phys_dest = rename->allocate(decode_packet.rd, rob_entry.old_phys_dest);
+        } else {
+            reg_status[decode_packet.rd].busy = true;
+            reg_status[decode_packet.rd].rob_entry = rob_index;
+        }
+    }
+    
+    // Snapshot the alias table after our own rename so recovery keeps the link register
+    if (rename_mode == RenameMode::MERGED && is_control) {
+        rob_entry.checkpoint = rename->take_checkpoint();
+    }
+    
+    rob->update_entry(rob_index, rob_entry);
+    
+    // In merged mode the predicted value sits in the destination register
+    // until the load completes; in ROB mode read_operand supplies it
+    if (rob_entry.value_predicted && rename_mode == RenameMode::MERGED) {
+        prf->write(rob_entry.phys_dest, rob_entry.predicted_value);
+        rename->set_ready(rob_entry.phys_dest);
+    }
+    
+    // The result of a zero idiom, or of a move whose source is available, is
+    // known now (one source of a move is x0, so the sum is the other source)
+    if (elimination != EliminationKind::NONE) {
+        if (perf) {
+            perf->record_elimination(elimination);
+        }
+        if (elimination == EliminationKind::ZERO_IDIOM) {
+            complete_at_rename(rob_index, decode_packet.opcode == Opcode::OP_IMM ?
+                               static_cast<RegisterValue>(static_cast<int64_t>(decode_packet.imm)) : 0);
+        } else if (rob_entry.move_tag == 0) {
+            complete_at_rename(rob_index, rs_entry.Vj + rs_entry.Vk);
+        }
     }
+    
+    return true;
 }
 
 void ExecutionUnit::execute_proc() {
     if (reset.read()) {
+        fu_pool->reset();
+        resolved_branches.clear();
+        report_resolved_branches();
+        redirect_out.write(false);
         return;
     }
     
-    // Execute ready instructions in the reservation stations
+    fu_pool->tick();
+    store_sets->tick();
     
-    // ALU operations
-    std::vector<std::pair<RSEntry, int>> alu_ready = rs_alu->get_ready_entries();
-    for (auto &entry_pair : alu_ready) {
-        ExecutePacket result;
-        result.valid = true;
-        
-        execute_alu_op(entry_pair.first, result);
-        
-        // Mark as completed in ROB
-        rob->complete_entry(entry_pair.second, result.result);
+    // Nothing to redirect unless a branch mispredicts this cycle
+    redirect_out.write(false);
+    
+    // Start ready instructions on free functional units
+    issue_ready(rs_alu);
+    issue_ready(rs_mem);
+    issue_ready(rs_branch);
+    
+    if (perf) {
+        const FUType types[] = {FUType::ALU, FUType::AGU, FUType::BRANCH, FUType::MUL, FUType::DIV};
+        for (FUType type : types) {
+            perf->record_fu_issue(type, fu_pool->issued_this_cycle(type), fu_pool->unit_count(type));
+        }
+    }
+    
+    // Write back the operations whose latency has elapsed, oldest first so
+    // that a misprediction squashes younger results before they complete
+    std::vector<FUOperation> finished = fu_pool->collect_finished();
+    std::sort(finished.begin(), finished.end(),
+              [this](const FUOperation& a, const FUOperation& b) {
+                  return rob->get_position(a.rob_index) < rob->get_position(b.rob_index);
+              });
+    for (auto &op : finished) {
+        if (!rob->is_entry_busy(op.rob_index)) {
+            continue; // Squashed by an older branch this cycle
+        }
         
-        // Remove from reservation station
-        rs_alu->remove_entry(entry_pair.second);
+        switch (op.type) {
+            case FUType::ALU:
+            case FUType::MUL:
+            case FUType::DIV:
+                // Mark as completed in ROB
+                rob->complete_entry(op.rob_index, op.result.result);
+                break;
+            
+            case FUType::AGU:
+                // For loads, mark as completed in ROB
+                if (op.entry.opcode == Opcode::LOAD) {
+                    rob->complete_entry(op.rob_index, op.result.result);
+                    validate_value_prediction(op.rob_index, op.entry, op.result.result);
+                } else if (op.entry.opcode == Opcode::STORE) {
+                    // For stores, update memory address and data in ROB
+                    rob->update_store_entry(op.rob_index, op.result.mem_addr, op.result.mem_data);
+                    
+                    // Loads in this store's set may now proceed
+                    store_sets->store_resolved(op.entry.pc, lsq->sequence_of(op.rob_index));
+                    
+                    // Younger loads that already ran past this store may have stale data
+                    int violator = lsq->resolve_store(op.rob_index, op.result.mem_addr,
+                                                      access_size(op.entry.funct3), op.result.mem_data);
+                    if (violator >= 0) {
+                        Address load_pc = rob->get_entry(violator).pc;
+                        if (perf) {
+                            perf->record_memory_order_violation();
+                        }
+                        if (mem_dep_policy == MemDepPolicy::STORE_SETS) {
+                            store_sets->record_violation(load_pc, op.entry.pc);
+                        }
+                        recover(rob->prev_index(violator), load_pc);
+                    }
+                }
+                break;
+            
+            case FUType::BRANCH:
+                // Update ROB with branch result
+                rob->complete_branch_entry(op.rob_index, op.result.result,
+                                           op.result.branch_taken, op.result.branch_target);
+                
+                // Queue the outcome for the branch predictor
+                resolved_branches.push_back(op.result);
+                
+                // Compare against the fetch-time prediction
+                resolve_branch(op.rob_index, op.entry, op.result);
+                break;
+        }
     }
     
-    // Memory operations
-    std::vector<std::pair<RSEntry, int>> mem_ready = rs_mem->get_ready_entries();
-    for (auto &entry_pair : mem_ready) {
+    report_resolved_branches();
+}
+
+void ExecutionUnit::report_resolved_branches() {
+    ExecuteBundle bundle;
+    bundle.count = 0;
+    while (!resolved_branches.empty() && bundle.count < MAX_PIPELINE_WIDTH) {
+        bundle.packets[bundle.count++] = resolved_branches.front();
+        resolved_branches.pop_front();
+    }
+    execute_out.write(bundle);
+}
+
+void ExecutionUnit::issue_ready(ReservationStation* rs) {
+    std::vector<std::pair<RSEntry, int>> ready = rs->get_ready_entries();
+    order_ready(ready);
+    
+    // Classes found busy this cycle; the ALU station feeds several classes,
+    // so a busy divider must not hold back ordinary ALU operations
+    std::set<FUType> busy;
+    
+    for (auto &entry_pair : ready) {
+        // Memory operations may be held back by dependence prediction
+        if (rs == rs_mem &&
+            !lsq->may_issue(entry_pair.second, mem_dep_policy == MemDepPolicy::CONSERVATIVE)) {
+            if (perf) {
+                perf->record_memory_dependence_wait();
+            }
+            continue;
+        }
+        
+        FUType type = FunctionalUnitPool::unit_for(entry_pair.first);
+        if (busy.count(type)) {
+            continue;
+        }
+        if (!fu_pool->can_issue(type)) {
+            // Operands are ready but every unit of this class is taken
+            if (perf) {
+                perf->record_fu_stall(type);
+            }
+            busy.insert(type);
+            continue;
+        }
+        
+        // Compute the result now; it is broadcast when the unit finishes
         ExecutePacket result;
         result.valid = true;
+        unsigned int mem_latency = 0;
         
-        execute_mem_op(entry_pair.first, result);
-        
-        // For loads, mark as completed in ROB
-        if (entry_pair.first.opcode == Opcode::LOAD) {
-            rob->complete_entry(entry_pair.second, result.result);
-        } else if (entry_pair.first.opcode == Opcode::STORE) {
-            // For stores, update memory address and data in ROB
-            rob->update_store_entry(entry_pair.second, result.mem_addr, result.mem_data);
+        switch (type) {
+            case FUType::ALU:
+            case FUType::MUL:
+            case FUType::DIV:
+                execute_alu_op(entry_pair.first, result);
+                break;
+            case FUType::AGU:
+                if (!execute_mem_op(entry_pair.first, entry_pair.second, result, mem_latency)) {
+                    continue; // Load waits for an overlapping store or a free MSHR
+                }
+                break;
+            case FUType::BRANCH:
+                execute_branch_op(entry_pair.first, result);
+                break;
         }
         
+        fu_pool->issue(entry_pair.second, entry_pair.first, result, mem_latency);
+        
         // Remove from reservation station
-        rs_mem->remove_entry(entry_pair.second);
+        rs->remove_entry(entry_pair.second);
+    }
+}
+
+void ExecutionUnit::order_ready(std::vector<std::pair<RSEntry, int>>& ready) const {
+    // Rank each candidate by the policy, breaking ties by age
+    std::vector<std::pair<int, std::pair<RSEntry, int>>> ranked;
+    for (auto &entry_pair : ready) {
+        int rank = 0;
+        switch (select_policy) {
+            case SelectPolicy::LOADS_FIRST:
+                rank = (entry_pair.first.opcode == Opcode::LOAD) ? 0 : 1;
+                break;
+            
+            case SelectPolicy::CRITICAL_PATH: {
+                int tag = result_tag(entry_pair.second);
+                rank = -(rs_alu->count_waiting(tag) + rs_mem->count_waiting(tag) +
+                         rs_branch->count_waiting(tag));
+                break;
+            }
+            
+            case SelectPolicy::OLDEST_FIRST:
+            default:
+                break;
+        }
+        ranked.push_back(std::make_pair(rank, entry_pair));
     }
     
-    // Branch operations
-    std::vector<std::pair<RSEntry, int>> branch_ready = rs_branch->get_ready_entries();
-    for (auto &entry_pair : branch_ready) {
-        ExecutePacket result;
-        result.valid = true;
-        
-        execute_branch_op(entry_pair.first, result);
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [this](const std::pair<int, std::pair<RSEntry, int>>& a,
+                            const std::pair<int, std::pair<RSEntry, int>>& b) {
+                         if (a.first != b.first) {
+                             return a.first < b.first;
+                         }
+                         return rob->get_position(a.second.second) < rob->get_position(b.second.second);
+                     });
+    
+    for (size_t i = 0; i < ready.size(); i++) {
+        ready[i] = ranked[i].second;
+    }
+}
+
+int ExecutionUnit::result_tag(int rob_index) const {
+    // Consumers wait on the physical register in merged mode, else on the ROB entry
+    if (rename_mode == RenameMode::MERGED) {
+        return rob->get_entry(rob_index).phys_dest + 1;
+    }
+    
+    return rob_index + 1;
+}
+
+void ExecutionUnit::complete_at_rename(int rob_index, RegisterValue value) {
+    rob->complete_entry(rob_index, value);
+    
+    // Consumers renamed after this instruction read the value directly
+    if (rename_mode == RenameMode::MERGED) {
+        int phys_reg = rob->get_entry(rob_index).phys_dest;
+        prf->write(phys_reg, value);
+        rename->set_ready(phys_reg);
+    }
+}
+
+void ExecutionUnit::resolve_moves(int tag, RegisterValue value) {
+    if (rob->is_empty()) {
+        return;
+    }
+    
+    // Eliminated moves of this result complete with it, in the same cycle,
+    // and wake their own consumers (and any moves of the move) right away
+    int head = rob->get_head_index();
+    int index = head;
+    do {
+        ROBEntry entry = rob->get_entry(index);
+        if (entry.move_tag == tag && !entry.completed) {
+            complete_at_rename(index, value);
+            
+            int move_tag = result_tag(index);
+            rs_alu->update_waiting_entries(move_tag, value);
+            rs_mem->update_waiting_entries(move_tag, value);
+            rs_branch->update_waiting_entries(move_tag, value);
+            resolve_moves(move_tag, value);
+        }
+        index = rob->next_index(index);
+    } while (index != head && rob->is_entry_busy(index));
+}
+
+void ExecutionUnit::resolve_branch(int rob_index, const RSEntry& entry, const ExecutePacket& result) {
+    ROBEntry rob_entry = rob->get_entry(rob_index);
+    Address actual_pc = result.branch_taken ? result.branch_target : entry.pc + entry.length;
+    
+    if (actual_pc != rob_entry.predicted_pc) {
+        if (perf) {
+            perf->record_control_hazard();
+        }
+        recover(rob_index, actual_pc);
+    }
+    
+    // The branch is resolved, so its checkpoint is no longer needed
+    if (rob_entry.checkpoint >= 0) {
+        rename->release_checkpoint(rob_entry.checkpoint);
+        rob_entry.checkpoint = -1;
+        rob->update_entry(rob_index, rob_entry);
+    }
+}
+
+void ExecutionUnit::validate_value_prediction(int rob_index, const RSEntry& entry, RegisterValue value) {
+    ROBEntry rob_entry = rob->get_entry(rob_index);
+    if (!rob_entry.value_predicted) {
+        return;
+    }
+    
+    bool correct = (rob_entry.predicted_value == value);
+    if (perf) {
+        perf->record_value_prediction(correct);
+    }
+    
+    // Consumers may have run with the wrong value; squash everything after
+    // the load and refetch (the load itself completed with the real data)
+    if (!correct) {
+        value_predictor->mispredicted(entry.pc);
+        recover(rob_index, entry.pc + entry.length);
+    }
+}
+
+void ExecutionUnit::recover(int rob_index, Address target) {
+    // A branch with a live checkpoint restores the alias table in one step;
+    // any other squash point undoes the squashed renames youngest first
+    ROBEntry survivor = rob->get_entry(rob_index);
+    bool from_checkpoint = (survivor.checkpoint >= 0);
+    
+    // Discard every instruction younger than the survivor
+    std::vector<int> squashed = rob->squash_after(rob_index);
+    for (int index : squashed) {
+        rs_alu->remove_entry(index);
+        rs_mem->remove_entry(index);
+        rs_branch->remove_entry(index);
+        fu_pool->squash(index);
+        lsq->squash(index);
         
-        // Update ROB with branch result
-        rob->complete_branch_entry(entry_pair.second, result.result, result.branch_taken, result.branch_target);
+        ROBEntry victim = rob->get_entry(index);
+        if (value_predictor && victim.opcode == Opcode::LOAD) {
+            value_predictor->squash(victim.pc);
+        }
         
-        // Output branch result for fetch unit
-        execute_out.write(result);
+        if (rename_mode == RenameMode::MERGED) {
+            if (!from_checkpoint && victim.phys_dest >= 0) {
+                rename->restore_mapping(victim.dest, victim.old_phys_dest);
+            }
+            rename->release(victim.phys_dest);
+            rename->release_checkpoint(victim.checkpoint);
+        }
+    }
+    
+    if (rename_mode == RenameMode::MERGED) {
+        if (from_checkpoint) {
+            rename->restore_checkpoint(survivor.checkpoint);
+        }
+    } else {
+        // reg_status maps to ROB entries, so rebuild it from the survivors
+        for (auto &status : reg_status) {
+            status.busy = false;
+        }
         
-        // Remove from reservation station
-        rs_branch->remove_entry(entry_pair.second);
+        int index = rob->get_head_index();
+        while (true) {
+            ROBEntry survivor = rob->get_entry(index);
+            if (writes_register(survivor.opcode, survivor.dest, survivor.fusion)) {
+                reg_status[survivor.dest].busy = true;
+                reg_status[survivor.dest].rob_entry = index;
+            }
+            
+            if (index == rob_index) {
+                break;
+            }
+            index = rob->next_index(index);
+        }
+    }
+    
+    // Wrong-path instructions waiting for dispatch go too
+    instruction_queue.clear();
+    refilling = true;
+    
+    // Restart fetch at the correct PC
+    redirect_out.write(true);
+    redirect_target.write(target);
+    
+    if (perf) {
+        perf->record_pipeline_flush();
+        perf->record_squashed(squashed.size());
     }
 }
 
@@ -272,15 +882,34 @@ void ExecutionUnit::complete_proc() {
     for (auto &completion : completed) {
         int rob_index = completion.first;
         RegisterValue value = completion.second;
+        int tag = rob_index + 1;
+        
+        // In merged mode the result lands in the physical register file and
+        // consumers are tagged with the physical register instead
+        if (rename_mode == RenameMode::MERGED) {
+            int phys_reg = rob->get_entry(rob_index).phys_dest;
+            if (phys_reg <= 0) {
+                continue; // No register result to broadcast
+            }
+            
+            prf->write(phys_reg, value);
+            rename->set_ready(phys_reg);
+            tag = phys_reg + 1;
+        }
         
         // Update ALU reservation station
-        rs_alu->update_waiting_entries(rob_index + 1, value);
+        rs_alu->update_waiting_entries(tag, value);
         
         // Update MEM reservation station
-        rs_mem->update_waiting_entries(rob_index + 1, value);
+        rs_mem->update_waiting_entries(tag, value);
         
         // Update Branch reservation station
-        rs_branch->update_waiting_entries(rob_index + 1, value);
+        rs_branch->update_waiting_entries(tag, value);
+        
+        // Eliminated moves of this result
+        if (eliminate_at_rename) {
+            resolve_moves(tag, value);
+        }
     }
 }
 
@@ -289,27 +918,211 @@ void ExecutionUnit::commit_proc() {
         return;
     }
     
-    // Commit completed entries from ROB in order
-    while (!rob->is_empty() && rob->is_head_completed()) {
+    // Write back the oldest buffered store line before retiring more stores
+    drain_store_buffer();
+    
+    // Commit completed entries from ROB in order, up to commit_width per cycle
+    unsigned int retired = 0;
+    unsigned int fused = 0;
+    bool store_buffer_full = false;
+    while (retired < commit_width && !rob->is_empty() && rob->is_head_completed()) {
         ROBEntry entry = rob->get_head_entry();
         
         if (entry.is_store) {
-            // For stores, perform the memory write
-            mem_interface->write_data(entry.mem_addr, entry.mem_data, 
-                                      (entry.funct3 == Funct3::SB) ? 1 :
-                                      (entry.funct3 == Funct3::SH) ? 2 : 4);
-        } else if (entry.dest != 0) {
-            // For other instructions, update register file
+            // Stores retire into the store buffer and reach memory later
+            uint8_t size = access_size(entry.funct3);
+            if (!store_buffer->can_accept(entry.mem_addr, size)) {
+                store_buffer_full = true;
+                break;
+            }
+            
+            bool combined = store_buffer->insert(entry.mem_addr, entry.mem_data, size);
+            if (perf) {
+                perf->record_store_buffer_insert(combined);
+            }
+            lsq->commit_store(rob->get_head_index());
+        } else if (writes_register(entry.opcode, entry.dest, entry.fusion)) {
+            // For other instructions, update register file (a branch's rd
+            // field holds immediate bits, not a destination)
             regfile->write(entry.dest, entry.value);
             
-            // Update register status
-            if (reg_status[entry.dest].rob_entry == rob->get_head_index()) {
+            if (rename_mode == RenameMode::MERGED) {
+                // No one can name the previous mapping any more
+                rename->release(entry.old_phys_dest);
+            } else if (reg_status[entry.dest].rob_entry == rob->get_head_index()) {
+                // Update register status
                 reg_status[entry.dest].busy = false;
             }
         }
         
+        // Loads leave the load queue as they retire and train the value
+        // predictor with the value they actually read
+        if (entry.opcode == Opcode::LOAD) {
+            lsq->commit_load(rob->get_head_index());
+            if (value_predictor && writes_register(entry.opcode, entry.dest, entry.fusion)) {
+                value_predictor->train(entry.pc, entry.value);
+            }
+        }
+        
+        if (perf) {
+            perf->record_retired_pc(entry.pc);
+        }
+        
+        // A fused pair takes one commit slot but counts as two instructions
+        if (entry.fusion != FusionKind::NONE) {
+            fused++;
+        }
+        
         // Remove from ROB
         rob->remove_head();
+        retired++;
+    }
+    
+    retired_count += retired + fused;
+    
+    if (perf) {
+        perf->record_retire(retired + fused);
+        perf->record_store_buffer_occupancy(store_buffer->occupancy());
+        
+        // Attribute every cycle that did not retire a full group
+        if (store_buffer_full) {
+            perf->record_retire_stall(RetireStall::STORE_BUFFER_FULL);
+        } else if (retired < commit_width) {
+            perf->record_retire_stall(classify_head_stall());
+        } else if (!rob->is_empty() && rob->is_head_completed()) {
+            perf->record_retire_stall(RetireStall::COMMIT_WIDTH);
+        }
+    }
+}
+
+RetireStall ExecutionUnit::classify_head_stall() const {
+    if (rob->is_empty()) {
+        return RetireStall::ROB_EMPTY;
+    }
+    
+    // The head is incomplete; blame the kind of instruction holding it up
+    switch (rob->get_head_entry().opcode) {
+        case Opcode::LOAD:
+            return RetireStall::HEAD_LOAD;
+        case Opcode::STORE:
+            return RetireStall::HEAD_STORE;
+        case Opcode::BRANCH:
+        case Opcode::JAL:
+        case Opcode::JALR:
+            return RetireStall::HEAD_BRANCH;
+        default:
+            return RetireStall::HEAD_ALU;
+    }
+}
+
+SlotLoss ExecutionUnit::classify_backend_stall(DispatchStall reason) const {
+    if (reason == DispatchStall::LQ_FULL || reason == DispatchStall::SQ_FULL) {
+        return SlotLoss::BACKEND_MEMORY;
+    }
+    
+    // Otherwise blame what is holding up the ROB head: a load waiting for
+    // data, or a store waiting for its address or the store buffer
+    if (!rob->is_empty()) {
+        ROBEntry head = rob->get_head_entry();
+        if ((head.opcode == Opcode::LOAD && !head.completed) || head.is_store) {
+            return SlotLoss::BACKEND_MEMORY;
+        }
+    }
+    
+    return SlotLoss::BACKEND_CORE;
+}
+
+void ExecutionUnit::read_operand(uint8_t reg, RegisterValue& value, uint16_t& tag) {
+    if (rename_mode == RenameMode::MERGED) {
+        int phys_reg = rename->lookup(reg);
+        if (rename->is_ready(phys_reg)) {
+            // Value is available in the physical register file
+            value = prf->read(phys_reg);
+            tag = 0;
+        } else {
+            // Wait for the producer of the physical register
+            value = 0;
+            tag = phys_reg + 1; // +1 to avoid 0, which means "available"
+        }
+        return;
+    }
+    
+    if (reg_status[reg].busy) {
+        // Register is waiting for a result
+        int wait_rob = reg_status[reg].rob_entry;
+        if (rob->is_entry_completed(wait_rob)) {
+            // Result is available in ROB
+            value = rob->get_entry_value(wait_rob);
+            tag = 0;
+        } else if (value_predictor && rob->get_entry(wait_rob).value_predicted) {
+            // Load with a predicted value, checked when the load completes
+            value = rob->get_entry(wait_rob).predicted_value;
+            tag = 0;
+        } else {
+            // Result is not yet available
+            value = 0;
+            tag = wait_rob + 1; // +1 to avoid 0, which means "available"
+        }
+    } else {
+        // Register is available in register file
+        value = regfile->read(reg);
+        tag = 0;
+    }
+}
+
+RegisterValue ExecutionUnit::read_memory(Address addr, uint8_t size) {
+    // Retired stores still in the store buffer are newer than memory
+    return store_buffer->forward(addr, size, mem_interface->read_data(addr, size));
+}
+
+void ExecutionUnit::drain_store_buffer() {
+    // A line that misses needs an MSHR for its fill
+    Address next_line;
+    if (store_buffer->peek(next_line) && !mem_interface->can_access_data(next_line)) {
+        return;
+    }
+    
+    StoreBufferLine line;
+    if (!store_buffer->drain(line)) {
+        return;
+    }
+    
+    // Write each run of valid bytes in the widest naturally aligned pieces
+    // that fit, so only ragged edges go to memory a byte at a time
+    size_t i = 0;
+    while (i < line.data.size()) {
+        if (!line.valid[i]) {
+            i++;
+            continue;
+        }
+        
+        uint8_t size = 8;
+        while (size > 1) {
+            bool fits = ((line.line_addr + i) % size == 0) && (i + size <= line.data.size());
+            for (size_t j = i; fits && j < i + size; j++) {
+                fits = line.valid[j];
+            }
+            if (fits) {
+                break;
+            }
+            size /= 2;
+        }
+        
+        RegisterValue value = 0;
+        for (uint8_t j = 0; j < size; j++) {
+            value |= static_cast<RegisterValue>(line.data[i + j]) << (8 * j);
+        }
+        mem_interface->write_data(line.line_addr + i, value, size);
+        i += size;
+    }
+    
+    // The cache is non-blocking: a miss is left to its MSHR and the write
+    // port is only busy for the lookup
+    unsigned int latency = mem_interface->access_data(line.line_addr, true, 0);
+    store_buffer->hold(std::min(latency, dcache_latency));
+    
+    if (perf) {
+        perf->record_memory_access(false, line.line_addr);
     }
 }
 
@@ -325,22 +1138,40 @@ void ExecutionUnit::execute_alu_op(RSEntry& entry, ExecutePacket& result) {
     RegisterValue op2;
     
     // For I-type instructions, use immediate as op2
-    if (entry.opcode == Opcode::OP_IMM) {
+    if (entry.opcode == Opcode::OP_IMM || entry.opcode == Opcode::OP_IMM_32) {
         op2 = entry.imm;
     } else {
         op2 = entry.Vk;
     }
     
+    // Fused slli + srli/srai: shift left then right, logical or arithmetic
+    // as the second shift was
+    if (entry.fusion == FusionKind::SHIFT_EXTEND) {
+        RegisterValue shifted = op1 << (entry.imm & 0x3F);
+        if (entry.funct7 & 0x20) {
+            result.result = static_cast<RegisterValue>(static_cast<int64_t>(shifted) >> (entry.imm2 & 0x3F));
+        } else {
+            result.result = shifted >> (entry.imm2 & 0x3F);
+        }
+        return;
+    }
+    
+    // Multiply and divide share the register-register opcodes (funct7 = 1)
+    if ((entry.opcode == Opcode::OP || entry.opcode == Opcode::OP_32) && entry.funct7 == 0x01) {
+        result.result = multiply_divide(entry.opcode == Opcode::OP_32, entry.funct3, op1, op2);
+        return;
+    }
+    
     // Execute based on opcode and function code
     switch (entry.opcode) {
         case Opcode::LUI:
             result.result = entry.imm;
             break;
-            
+        
         case Opcode::AUIPC:
             result.result = entry.pc + entry.imm;
             break;
-            
+        
         case Opcode::OP:
         case Opcode::OP_IMM:
             switch (entry.funct3) {
@@ -353,33 +1184,34 @@ void ExecutionUnit::execute_alu_op(RSEntry& entry, ExecutePacket& result) {
                         result.result = op1 + op2;
                     }
                     break;
-                    
+                
                 case Funct3::SLT:
                     result.result = (static_cast<int64_t>(op1) < static_cast<int64_t>(op2)) ? 1 : 0;
                     break;
-                    
+                
                 case Funct3::SLTU:
                     result.result = (op1 < op2) ? 1 : 0;
                     break;
-                    
+                
                 case Funct3::XOR:
                     result.result = op1 ^ op2;
                     break;
-                    
+                
                 case Funct3::OR:
                     result.result = op1 | op2;
                     break;
-                    
+                
                 case Funct3::AND:
                     result.result = op1 & op2;
                     break;
-                    
+                
                 case Funct3::SLL:
                     result.result = op1 << (op2 & 0x3F);
                     break;
-                    
+                
                 case Funct3::SRL:
-                    if (entry.opcode == Opcode::OP && (entry.funct7 & 0x20)) {
+                    // SRA/SRAI (for SRAI the bit sits in the immediate's funct7 field)
+                    if (entry.funct7 & 0x20) {
                         // SRA operation
                         result.result = static_cast<int64_t>(op1) >> (op2 & 0x3F);
                     } else {
@@ -387,20 +1219,60 @@ void ExecutionUnit::execute_alu_op(RSEntry& entry, ExecutePacket& result) {
                         result.result = op1 >> (op2 & 0x3F);
                     }
                     break;
-                    
+                
                 default:
                     result.result = 0;
                     break;
             }
             break;
-            
+        
+        case Opcode::OP_32:
+        case Opcode::OP_IMM_32: {
+            // RV64 word operations: compute on the low 32 bits and
+            // sign-extend the result
+            uint32_t a = static_cast<uint32_t>(op1);
+            uint32_t b = static_cast<uint32_t>(op2);
+            uint32_t word = 0;
+            switch (entry.funct3) {
+                case Funct3::ADD:
+                    if (entry.opcode == Opcode::OP_32 && (entry.funct7 & 0x20)) {
+                        // SUBW
+                        word = a - b;
+                    } else {
+                        // ADDW/ADDIW
+                        word = a + b;
+                    }
+                    break;
+                
+                case Funct3::SLL:
+                    word = a << (b & 0x1F);
+                    break;
+                
+                case Funct3::SRL:
+                    if (entry.funct7 & 0x20) {
+                        // SRAW/SRAIW
+                        word = static_cast<uint32_t>(static_cast<int32_t>(a) >> (b & 0x1F));
+                    } else {
+                        // SRLW/SRLIW
+                        word = a >> (b & 0x1F);
+                    }
+                    break;
+                
+                default:
+                    break;
+            }
+            result.result = static_cast<RegisterValue>(static_cast<int64_t>(static_cast<int32_t>(word)));
+            break;
+        }
+        
         default:
             result.result = 0;
             break;
     }
 }
 
-void ExecutionUnit::execute_mem_op(RSEntry& entry, ExecutePacket& result) {
+bool ExecutionUnit::execute_mem_op(RSEntry& entry, int rob_index, ExecutePacket& result,
+                                   unsigned int& mem_latency) {
     result.instruction = 0; // Not needed for execution result
     result.pc = entry.pc;
     result.rd = entry.rd;
@@ -414,10 +1286,39 @@ void ExecutionUnit::execute_mem_op(RSEntry& entry, ExecutePacket& result) {
     
     if (entry.opcode == Opcode::LOAD) {
         // Execute load operation
-        uint8_t size = (entry.funct3 == Funct3::LB || entry.funct3 == Funct3::LBU) ? 1 :
-                       (entry.funct3 == Funct3::LH || entry.funct3 == Funct3::LHU) ? 2 : 4;
+        uint8_t size = access_size(entry.funct3);
         
-        RegisterValue data = mem_interface->read_data(addr, size);
+        // Take the data from an older in-flight store if one covers the
+        // load, otherwise read through the data cache
+        RegisterValue data = 0;
+        uint64_t source = 0;
+        switch (lsq->forward_load(rob_index, addr, size, data, source)) {
+            case LoadForward::BLOCKED:
+                if (perf) {
+                    perf->record_load_blocked();
+                }
+                return false;
+            
+            case LoadForward::FORWARDED:
+                mem_latency = 1;
+                if (perf) {
+                    perf->record_store_forward();
+                }
+                break;
+            
+            case LoadForward::NONE:
+                // A miss needs an MSHR; without one the load retries later
+                if (!mem_interface->can_access_data(addr)) {
+                    return false;
+                }
+                data = read_memory(addr, size);
+                mem_latency = mem_interface->access_data(addr, false, entry.pc);
+                if (perf) {
+                    perf->record_memory_access(true, addr);
+                }
+                break;
+        }
+        lsq->load_executed(rob_index, addr, size, source);
         
         // Handle sign extension for signed loads
         if (entry.funct3 == Funct3::LB) {
@@ -437,6 +1338,8 @@ void ExecutionUnit::execute_mem_op(RSEntry& entry, ExecutePacket& result) {
         result.mem_data = entry.Vk;
         result.result = 0; // Stores don't produce a result
     }
+    
+    return true;
 }
 
 void ExecutionUnit::execute_branch_op(RSEntry& entry, ExecutePacket& result) {
@@ -448,50 +1351,64 @@ void ExecutionUnit::execute_branch_op(RSEntry& entry, ExecutePacket& result) {
     
     // Default to not taken
     result.branch_taken = false;
-    result.branch_target = entry.pc + 4;
+    result.branch_target = entry.pc + entry.length;
     
     switch (entry.opcode) {
         case Opcode::JAL:
             // Unconditional jump
-            result.result = entry.pc + 4; // Return address
+            result.result = entry.pc + entry.length; // Return address
             result.branch_taken = true;
             result.branch_target = entry.pc + entry.imm;
             break;
-            
+        
         case Opcode::JALR:
             // Jump and link register
-            result.result = entry.pc + 4; // Return address
+            result.result = entry.pc + entry.length; // Return address
             result.branch_taken = true;
             result.branch_target = (entry.Vj + entry.imm) & ~1; // Clear lowest bit
             break;
-            
+        
         case Opcode::BRANCH:
+            if (entry.fusion == FusionKind::COMPARE_BRANCH) {
+                // Fused slt/sltu + beqz/bnez: the compare result is written
+                // to rd and decides the branch
+                bool less = (static_cast<Funct3>(entry.imm2) == Funct3::SLTU) ?
+                    (entry.Vj < entry.Vk) :
+                    (static_cast<int64_t>(entry.Vj) < static_cast<int64_t>(entry.Vk));
+                result.result = less ? 1 : 0;
+                result.branch_taken = (entry.funct3 == Funct3::BNE) ? less : !less;
+                if (result.branch_taken) {
+                    result.branch_target = entry.pc + entry.imm;
+                }
+                break;
+            }
+            
             // Conditional branches
             switch (entry.funct3) {
                 case Funct3::BEQ:
                     result.branch_taken = (entry.Vj == entry.Vk);
                     break;
-                    
+                
                 case Funct3::BNE:
                     result.branch_taken = (entry.Vj != entry.Vk);
                     break;
-                    
+                
                 case Funct3::BLT:
                     result.branch_taken = (static_cast<int64_t>(entry.Vj) < static_cast<int64_t>(entry.Vk));
                     break;
-                    
+                
                 case Funct3::BGE:
                     result.branch_taken = (static_cast<int64_t>(entry.Vj) >= static_cast<int64_t>(entry.Vk));
                     break;
-                    
+                
                 case Funct3::BLTU:
                     result.branch_taken = (entry.Vj < entry.Vk);
                     break;
-                    
+                
                 case Funct3::BGEU:
                     result.branch_taken = (entry.Vj >= entry.Vk);
                     break;
-                    
+                
                 default:
                     result.branch_taken = false;
                     break;
@@ -503,7 +1420,7 @@ void ExecutionUnit::execute_branch_op(RSEntry& entry, ExecutePacket& result) {
             
             result.result = 0; // Branches don't produce a register result
             break;
-            
+        
         default:
             result.result = 0;
             break;
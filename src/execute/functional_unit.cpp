@@ -0,0 +1,221 @@
+#include "execute/functional_unit.h"
+
+FunctionalUnitPool::FunctionalUnitPool(sc_module_name name, const ProcessorConfig& config)
+    : sc_module(name), cycle(0), issued_cycle(0) {
+    unit_config[FUType::ALU] = config.alu_units;
+    unit_config[FUType::AGU] = config.agu_units;
+    unit_config[FUType::BRANCH] = config.branch_units;
+    unit_config[FUType::MUL] = config.mul_units;
+    unit_config[FUType::DIV] = config.div_units;
+    
+    // Every class needs at least one unit and a latency of at least one cycle
+    for (auto &unit : unit_config) {
+        if (unit.second.count == 0) unit.second.count = 1;
+        if (unit.second.latency == 0) unit.second.latency = 1;
+        busy_until[unit.first].resize(unit.second.count);
+    }
+    
+    // Default latencies come from the unit class
+    const Opcode opcodes[] = {
+        Opcode::LUI, Opcode::AUIPC, Opcode::JAL, Opcode::JALR, Opcode::BRANCH,
+        Opcode::LOAD, Opcode::STORE, Opcode::OP_IMM, Opcode::OP, Opcode::SYSTEM,
+        Opcode::OP_IMM_32, Opcode::OP_32
+    };
+    for (Opcode opcode : opcodes) {
+        op_latency[opcode] = unit_config[unit_for(opcode)].latency;
+    }
+    
+    for (const auto &entry : config.opcode_latency) {
+        set_latency(entry.first, entry.second);
+    }
+    
+    reset();
+}
+
+void FunctionalUnitPool::reset() {
+    for (auto &units : busy_until) {
+        for (auto &until : units.second) {
+            until = 0;
+        }
+    }
+    
+    issued.clear();
+    in_flight.clear();
+    cycle = 1;
+    issued_cycle = 0;
+}
+
+FUType FunctionalUnitPool::unit_for(const RSEntry& entry) {
+    // The M extension shares the register-register opcodes, with funct7 = 1
+    if ((entry.opcode == Opcode::OP || entry.opcode == Opcode::OP_32) && entry.funct7 == 0x01) {
+        return static_cast<uint32_t>(entry.funct3) >= static_cast<uint32_t>(Funct3::DIV) ?
+            FUType::DIV : FUType::MUL;
+    }
+    
+    return unit_for(entry.opcode);
+}
+
+FUType FunctionalUnitPool::unit_for(Opcode opcode) {
+    switch (opcode) {
+        case Opcode::LOAD:
+        case Opcode::STORE:
+            return FUType::AGU;
+        
+        case Opcode::BRANCH:
+        case Opcode::JAL:
+        case Opcode::JALR:
+            return FUType::BRANCH;
+        
+        default:
+            return FUType::ALU;
+    }
+}
+
+unsigned int FunctionalUnitPool::latency(Opcode opcode) const {
+    auto it = op_latency.find(opcode);
+    if (it == op_latency.end()) {
+        return 1;
+    }
+    
+    return it->second;
+}
+
+unsigned int FunctionalUnitPool::latency(const RSEntry& entry) const {
+    switch (unit_for(entry)) {
+        case FUType::MUL:
+            return unit_config.at(FUType::MUL).latency;
+        case FUType::DIV:
+            return divide_latency(entry);
+        default:
+            return latency(entry.opcode);
+    }
+}
+
+unsigned int FunctionalUnitPool::divide_latency(const RSEntry& entry) const {
+    // The divider spends one cycle on setup and then iterates only over the
+    // quotient bits the operands can produce, at the rate that gives the
+    // configured latency for a full 64-bit quotient
+    unsigned int max_latency = unit_config.at(FUType::DIV).latency;
+    bool word = (entry.opcode == Opcode::OP_32);
+    bool is_signed = (entry.funct3 == Funct3::DIV || entry.funct3 == Funct3::REM);
+    
+    uint64_t dividend = entry.Vj;
+    uint64_t divisor = entry.Vk;
+    if (word) {
+        dividend = is_signed ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(dividend)))
+                             : static_cast<uint32_t>(dividend);
+        divisor = is_signed ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(divisor)))
+                            : static_cast<uint32_t>(divisor);
+    }
+    if (is_signed) {
+        if (static_cast<int64_t>(dividend) < 0) dividend = 0 - dividend;
+        if (static_cast<int64_t>(divisor) < 0) divisor = 0 - divisor;
+    }
+    
+    // Division by zero and a divisor larger than the dividend need no iterations
+    if (divisor == 0 || divisor > dividend) {
+        return std::min(2u, max_latency);
+    }
+    
+    unsigned int dividend_bits = 64 - __builtin_clzll(dividend);
+    unsigned int divisor_bits = 64 - __builtin_clzll(divisor);
+    unsigned int quotient_bits = dividend_bits - divisor_bits + 1;
+    
+    unsigned int iterations = (quotient_bits * (max_latency - 1) + 63) / 64;
+    return std::min(std::max(1 + iterations, 2u), max_latency);
+}
+
+void FunctionalUnitPool::set_latency(Opcode opcode, unsigned int cycles) {
+    op_latency[opcode] = cycles > 0 ? cycles : 1;
+}
+
+bool FunctionalUnitPool::can_issue(FUType type) const {
+    for (uint64_t until : busy_until.at(type)) {
+        if (until < cycle) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool FunctionalUnitPool::issue(int rob_index, const RSEntry& entry, const ExecutePacket& result,
+                               unsigned int extra_latency) {
+    FUType type = unit_for(entry);
+    unsigned int unit_latency = latency(entry);
+    
+    std::vector<uint64_t> &units = busy_until[type];
+    for (unsigned int unit = 0; unit < units.size(); unit++) {
+        uint64_t &until = units[unit];
+        if (until >= cycle) {
+            continue;
+        }
+        
+        FUOperation op;
+        op.rob_index = rob_index;
+        op.entry = entry;
+        op.result = result;
+        op.type = type;
+        op.unit = unit;
+        op.finish_cycle = cycle + unit_latency + extra_latency - 1;
+        
+        // A pipelined unit is free again next cycle; an unpipelined one
+        // stays occupied until its own part of the operation is done
+        until = unit_config[type].pipelined ? cycle : cycle + unit_latency - 1;
+        op.unit_busy_until = until;
+        in_flight.push_back(op);
+        
+        if (issued_cycle != cycle) {
+            issued.clear();
+            issued_cycle = cycle;
+        }
+        issued[type]++;
+        
+        return true;
+    }
+    
+    return false;
+}
+
+std::vector<FUOperation> FunctionalUnitPool::collect_finished() {
+    std::vector<FUOperation> finished;
+    
+    for (auto it = in_flight.begin(); it != in_flight.end();) {
+        if (it->finish_cycle <= cycle) {
+            finished.push_back(*it);
+            it = in_flight.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    
+    return finished;
+}
+
+void FunctionalUnitPool::squash(int rob_index) {
+    for (auto it = in_flight.begin(); it != in_flight.end();) {
+        if (it->rob_index == rob_index) {
+            // A unit still occupied by the operation is free again
+            uint64_t &until = busy_until[it->type][it->unit];
+            if (until == it->unit_busy_until && until >= cycle) {
+                until = cycle - 1;
+            }
+            it = in_flight.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+unsigned int FunctionalUnitPool::unit_count(FUType type) const {
+    return unit_config.at(type).count;
+}
+
+unsigned int FunctionalUnitPool::issued_this_cycle(FUType type) const {
+    if (issued_cycle != cycle) {
+        return 0;
+    }
+    
+    auto it = issued.find(type);
+    return it == issued.end() ? 0 : it->second;
+}
@@ -0,0 +1,214 @@
+#include "execute/load_store_queue.h"
+
+LoadStoreQueue::LoadStoreQueue(sc_module_name name, int load_entries, int store_entries)
+    : sc_module(name), max_loads(load_entries), max_stores(store_entries),
+      next_seq(1) {
+    if (max_loads < 1) max_loads = 1;
+    if (max_stores < 1) max_stores = 1;
+}
+
+void LoadStoreQueue::reset() {
+    load_queue.clear();
+    store_queue.clear();
+    next_seq = 1;
+}
+
+bool LoadStoreQueue::is_load_queue_full() const {
+    return static_cast<int>(load_queue.size()) >= max_loads;
+}
+
+bool LoadStoreQueue::is_store_queue_full() const {
+    return static_cast<int>(store_queue.size()) >= max_stores;
+}
+
+uint64_t LoadStoreQueue::allocate_load(int rob_index, uint64_t wait_seq) {
+    LoadQueueEntry entry;
+    entry.seq = next_seq++;
+    entry.rob_index = rob_index;
+    entry.executed = false;
+    entry.addr = 0;
+    entry.size = 0;
+    entry.source_seq = 0;
+    entry.wait_seq = wait_seq;
+    load_queue.push_back(entry);
+    
+    return entry.seq;
+}
+
+uint64_t LoadStoreQueue::allocate_store(int rob_index, uint64_t wait_seq) {
+    StoreQueueEntry entry;
+    entry.seq = next_seq++;
+    entry.rob_index = rob_index;
+    entry.resolved = false;
+    entry.addr = 0;
+    entry.size = 0;
+    entry.data = 0;
+    entry.wait_seq = wait_seq;
+    store_queue.push_back(entry);
+    
+    return entry.seq;
+}
+
+bool LoadStoreQueue::may_issue(int rob_index, bool conservative) const {
+    for (const auto &load : load_queue) {
+        if (load.rob_index != rob_index) {
+            continue;
+        }
+        
+        if (conservative) {
+            for (const auto &store : store_queue) {
+                if (store.seq < load.seq && !store.resolved) {
+                    return false;
+                }
+            }
+        }
+        
+        return !is_store_pending(load.wait_seq);
+    }
+    
+    for (const auto &store : store_queue) {
+        if (store.rob_index == rob_index) {
+            return !is_store_pending(store.wait_seq);
+        }
+    }
+    
+    return true;
+}
+
+uint64_t LoadStoreQueue::sequence_of(int rob_index) const {
+    for (const auto &load : load_queue) {
+        if (load.rob_index == rob_index) {
+            return load.seq;
+        }
+    }
+    
+    for (const auto &store : store_queue) {
+        if (store.rob_index == rob_index) {
+            return store.seq;
+        }
+    }
+    
+    return 0;
+}
+
+bool LoadStoreQueue::is_store_pending(uint64_t seq) const {
+    if (seq == 0) {
+        return false;
+    }
+    
+    for (const auto &store : store_queue) {
+        if (store.seq == seq) {
+            return !store.resolved;
+        }
+    }
+    
+    return false;
+}
+
+LoadForward LoadStoreQueue::forward_load(int rob_index, Address addr, uint8_t size,
+                                         RegisterValue& data, uint64_t& source_seq) const {
+    source_seq = 0;
+    
+    uint64_t load_seq = 0;
+    for (const auto &load : load_queue) {
+        if (load.rob_index == rob_index) {
+            load_seq = load.seq;
+            break;
+        }
+    }
+    
+    // The youngest older store with a known overlapping address decides;
+    // stores whose address is unknown are speculatively ignored
+    for (auto it = store_queue.rbegin(); it != store_queue.rend(); ++it) {
+        if (it->seq > load_seq || !it->resolved || !overlaps(it->addr, it->size, addr, size)) {
+            continue;
+        }
+        
+        if (addr < it->addr || addr + size > it->addr + it->size) {
+            return LoadForward::BLOCKED;
+        }
+        
+        // Extract the loaded bytes from the store data
+        data = it->data >> ((addr - it->addr) * 8);
+        if (size < 8) {
+            data &= (static_cast<RegisterValue>(1) << (size * 8)) - 1;
+        }
+        source_seq = it->seq;
+        return LoadForward::FORWARDED;
+    }
+    
+    return LoadForward::NONE;
+}
+
+void LoadStoreQueue::load_executed(int rob_index, Address addr, uint8_t size, uint64_t source_seq) {
+    for (auto &load : load_queue) {
+        if (load.rob_index == rob_index) {
+            load.executed = true;
+            load.addr = addr;
+            load.size = size;
+            load.source_seq = source_seq;
+            return;
+        }
+    }
+}
+
+int LoadStoreQueue::resolve_store(int rob_index, Address addr, uint8_t size, RegisterValue data) {
+    uint64_t store_seq = 0;
+    for (auto &store : store_queue) {
+        if (store.rob_index == rob_index) {
+            store.resolved = true;
+            store.addr = addr;
+            store.size = size;
+            store.data = data;
+            store_seq = store.seq;
+            break;
+        }
+    }
+    
+    if (store_seq == 0) {
+        return -1;
+    }
+    
+    // A younger load that already read this location from something older
+    // than this store has the wrong value
+    for (const auto &load : load_queue) {
+        if (load.seq > store_seq && load.executed && load.source_seq < store_seq &&
+            overlaps(load.addr, load.size, addr, size)) {
+            return load.rob_index;
+        }
+    }
+    
+    return -1;
+}
+
+void LoadStoreQueue::commit_load(int rob_index) {
+    if (!load_queue.empty() && load_queue.front().rob_index == rob_index) {
+        load_queue.pop_front();
+    }
+}
+
+void LoadStoreQueue::commit_store(int rob_index) {
+    if (!store_queue.empty() && store_queue.front().rob_index == rob_index) {
+        store_queue.pop_front();
+    }
+}
+
+void LoadStoreQueue::squash(int rob_index) {
+    for (auto it = load_queue.begin(); it != load_queue.end(); ++it) {
+        if (it->rob_index == rob_index) {
+            load_queue.erase(it);
+            return;
+        }
+    }
+    
+    for (auto it = store_queue.begin(); it != store_queue.end(); ++it) {
+        if (it->rob_index == rob_index) {
+            store_queue.erase(it);
+            return;
+        }
+    }
+}
+
+bool LoadStoreQueue::overlaps(Address a, uint8_t a_size, Address b, uint8_t b_size) {
+    return a < b + b_size && b < a + a_size;
+}
@@ -0,0 +1,88 @@
+#include "execute/load_value_predictor.h"
+
+LoadValuePredictor::LoadValuePredictor(sc_module_name name, unsigned int entries,
+                                       unsigned int confidence_threshold)
+    : sc_module(name),
+      num_entries(entries > 0 ? entries : 1),
+      threshold(confidence_threshold < MAX_CONFIDENCE ? confidence_threshold : MAX_CONFIDENCE) {
+    table.resize(num_entries);
+    reset();
+}
+
+void LoadValuePredictor::reset() {
+    for (auto &entry : table) {
+        entry.valid = false;
+        entry.tag = 0;
+        entry.last_value = 0;
+        entry.stride = 0;
+        entry.confidence = 0;
+        entry.inflight = 0;
+    }
+}
+
+LoadValuePredictor::Entry* LoadValuePredictor::find(Address pc) {
+    Entry &entry = table[(pc >> 1) % num_entries];
+    if (!entry.valid || entry.tag != pc) {
+        return nullptr;
+    }
+    
+    return &entry;
+}
+
+bool LoadValuePredictor::predict(Address pc, RegisterValue& value) {
+    Entry* entry = find(pc);
+    if (!entry) {
+        return false;
+    }
+    
+    // Each older instance still in flight advances the sequence by one stride
+    bool confident = entry->confidence >= threshold;
+    value = entry->last_value + static_cast<RegisterValue>(entry->stride) * (entry->inflight + 1);
+    entry->inflight++;
+    
+    return confident;
+}
+
+void LoadValuePredictor::train(Address pc, RegisterValue value) {
+    Entry* entry = find(pc);
+    if (!entry) {
+        // Allocate on first retirement, replacing whatever held the slot
+        Entry &slot = table[(pc >> 1) % num_entries];
+        slot.valid = true;
+        slot.tag = pc;
+        slot.last_value = value;
+        slot.stride = 0;
+        slot.confidence = 0;
+        slot.inflight = 0;
+        return;
+    }
+    
+    int64_t stride = static_cast<int64_t>(value - entry->last_value);
+    if (stride == entry->stride) {
+        if (entry->confidence < MAX_CONFIDENCE) {
+            entry->confidence++;
+        }
+    } else {
+        entry->stride = stride;
+        entry->confidence = 0;
+    }
+    
+    entry->last_value = value;
+    if (entry->inflight > 0) {
+        entry->inflight--;
+    }
+}
+
+void LoadValuePredictor::squash(Address pc) {
+    Entry* entry = find(pc);
+    if (entry && entry->inflight > 0) {
+        entry->inflight--;
+    }
+}
+
+void LoadValuePredictor::mispredicted(Address pc) {
+    Entry* entry = find(pc);
+    if (entry) {
+        entry->confidence = 0;
+    }
+}
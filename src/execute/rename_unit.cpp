@@ -0,0 +1,140 @@
+#include "execute/rename_unit.h"
+
+RenameUnit::RenameUnit(sc_module_name name, int arch_regs, int phys_regs, int checkpoint_count)
+    : sc_module(name), num_arch_regs(arch_regs), num_phys_regs(phys_regs) {
+    // Every architectural register needs a home plus at least one spare
+    if (num_phys_regs <= num_arch_regs) {
+        num_phys_regs = num_arch_regs + 1;
+    }
+    
+    rat.resize(num_arch_regs);
+    ready.resize(num_phys_regs);
+    checkpoints.resize(checkpoint_count, std::vector<int>(num_arch_regs));
+    checkpoint_used.resize(checkpoint_count);
+    
+    reset();
+}
+
+void RenameUnit::reset() {
+    // Architectural register i starts out in physical register i
+    for (int i = 0; i < num_arch_regs; i++) {
+        rat[i] = i;
+    }
+    
+    free_list.clear();
+    for (int i = num_arch_regs; i < num_phys_regs; i++) {
+        free_list.push_back(i);
+    }
+    
+    for (int i = 0; i < num_phys_regs; i++) {
+        ready[i] = true;
+    }
+    
+    for (size_t i = 0; i < checkpoint_used.size(); i++) {
+        checkpoint_used[i] = false;
+    }
+}
+
+int RenameUnit::lookup(int arch_reg) const {
+    if (arch_reg < 0 || arch_reg >= num_arch_regs) {
+        return 0;
+    }
+    
+    return rat[arch_reg];
+}
+
+bool RenameUnit::has_free_register() const {
+    return !free_list.empty();
+}
+
+int RenameUnit::allocated_count() const {
+    return num_phys_regs - static_cast<int>(free_list.size());
+}
+
+int RenameUnit::allocate(int arch_reg, int& old_phys_reg) {
+    old_phys_reg = -1;
+    
+    // x0 is never renamed
+    if (arch_reg <= 0 || arch_reg >= num_arch_regs || free_list.empty()) {
+        return -1;
+    }
+    
+    int phys_reg = free_list.front();
+    free_list.pop_front();
+    
+    old_phys_reg = rat[arch_reg];
+    rat[arch_reg] = phys_reg;
+    ready[phys_reg] = false;
+    
+    return phys_reg;
+}
+
+void RenameUnit::restore_mapping(int arch_reg, int phys_reg) {
+    if (arch_reg <= 0 || arch_reg >= num_arch_regs || phys_reg < 0 || phys_reg >= num_phys_regs) {
+        return;
+    }
+    
+    rat[arch_reg] = phys_reg;
+}
+
+void RenameUnit::release(int phys_reg) {
+    // Physical register 0 backs x0 and is never freed
+    if (phys_reg <= 0 || phys_reg >= num_phys_regs) {
+        return;
+    }
+    
+    ready[phys_reg] = true;
+    free_list.push_back(phys_reg);
+}
+
+bool RenameUnit::is_ready(int phys_reg) const {
+    if (phys_reg < 0 || phys_reg >= num_phys_regs) {
+        return true;
+    }
+    
+    return ready[phys_reg];
+}
+
+void RenameUnit::set_ready(int phys_reg) {
+    if (phys_reg < 0 || phys_reg >= num_phys_regs) {
+        return;
+    }
+    
+    ready[phys_reg] = true;
+}
+
+bool RenameUnit::has_free_checkpoint() const {
+    for (size_t i = 0; i < checkpoint_used.size(); i++) {
+        if (!checkpoint_used[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int RenameUnit::take_checkpoint() {
+    for (size_t i = 0; i < checkpoint_used.size(); i++) {
+        if (!checkpoint_used[i]) {
+            checkpoint_used[i] = true;
+            checkpoints[i] = rat;
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void RenameUnit::restore_checkpoint(int id) {
+    if (id < 0 || id >= static_cast<int>(checkpoints.size()) || !checkpoint_used[id]) {
+        return;
+    }
+    
+    rat = checkpoints[id];
+}
+
+void RenameUnit::release_checkpoint(int id) {
+    if (id < 0 || id >= static_cast<int>(checkpoint_used.size())) {
+        return;
+    }
+    
+    checkpoint_used[id] = false;
+}
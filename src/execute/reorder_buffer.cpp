@@ -145,3 +145,58 @@ std::vector<std::pair<int, RegisterValue>> ReorderBuffer::get_newly_completed()
     
     return completed_entries;
 }
+
+ROBEntry ReorderBuffer::get_entry(int index) const {
+    if (index < 0 || index >= max_entries) {
+        ROBEntry empty;
+        empty.busy = false;
+        return empty;
+    }
+    
+    return entries[index];
+}
+
+bool ReorderBuffer::is_entry_busy(int index) const {
+    if (index < 0 || index >= max_entries) {
+        return false;
+    }
+    
+    return entries[index].busy;
+}
+
+int ReorderBuffer::next_index(int index) const {
+    return (index + 1) % max_entries;
+}
+
+int ReorderBuffer::prev_index(int index) const {
+    return (index - 1 + max_entries) % max_entries;
+}
+
+int ReorderBuffer::get_position(int index) const {
+    return (index - head + max_entries) % max_entries;
+}
+
+std::vector<int> ReorderBuffer::squash_after(int index) {
+    std::vector<int> squashed;
+    
+    if (!is_entry_busy(index)) {
+        return squashed;
+    }
+    
+    // Walk back from the tail until we reach the surviving entry
+    while (count > 0) {
+        int youngest = (tail - 1 + max_entries) % max_entries;
+        if (youngest == index) {
+            break;
+        }
+        
+        entries[youngest].busy = false;
+        newly_completed[youngest] = false;
+        squashed.push_back(youngest);
+        
+        tail = youngest;
+        count--;
+    }
+    
+    return squashed;
+}
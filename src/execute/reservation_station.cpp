@@ -59,6 +59,21 @@ std::vector<std::pair<RSEntry, int>> ReservationStation::get_ready_entries() {
     return ready_entries;
 }
 
+int ReservationStation::count_waiting(int tag) const {
+    if (tag == 0) {
+        return 0;
+    }
+    
+    int waiting = 0;
+    for (int i = 0; i < max_entries; i++) {
+        if (entries[i].busy && (entries[i].Qj == tag || entries[i].Qk == tag)) {
+            waiting++;
+        }
+    }
+    
+    return waiting;
+}
+
 void ReservationStation::update_waiting_entries(int tag, RegisterValue value) {
     // Skip if tag is 0 (indicates no dependency)
     if (tag == 0) {
@@ -0,0 +1,110 @@
+#include "execute/store_buffer.h"
+
+StoreBuffer::StoreBuffer(sc_module_name name, int lines, int line_size, unsigned int drain_interval)
+    : sc_module(name),
+      max_lines(lines > 0 ? lines : 1),
+      line_bytes(line_size >= 8 ? line_size : 8),
+      drain_cycles(drain_interval > 0 ? drain_interval : 1),
+      drain_wait(0) {
+}
+
+void StoreBuffer::reset() {
+    lines.clear();
+    drain_wait = 0;
+}
+
+StoreBufferLine* StoreBuffer::find_line(Address line_addr) {
+    for (auto &line : lines) {
+        if (line.line_addr == line_addr) {
+            return &line;
+        }
+    }
+    
+    return nullptr;
+}
+
+const StoreBufferLine* StoreBuffer::find_line(Address line_addr) const {
+    for (const auto &line : lines) {
+        if (line.line_addr == line_addr) {
+            return &line;
+        }
+    }
+    
+    return nullptr;
+}
+
+bool StoreBuffer::can_accept(Address addr, uint8_t size) const {
+    // Lines already buffered absorb the store; only new lines need space
+    int needed = 0;
+    for (Address line_addr = line_of(addr); line_addr <= line_of(addr + size - 1); line_addr += line_bytes) {
+        if (!find_line(line_addr)) {
+            needed++;
+        }
+    }
+    
+    return static_cast<int>(lines.size()) + needed <= max_lines;
+}
+
+bool StoreBuffer::insert(Address addr, RegisterValue data, uint8_t size) {
+    bool combined = true;
+    
+    for (uint8_t i = 0; i < size; i++) {
+        Address byte_addr = addr + i;
+        Address line_addr = line_of(byte_addr);
+        
+        StoreBufferLine* line = find_line(line_addr);
+        if (!line) {
+            StoreBufferLine fresh;
+            fresh.line_addr = line_addr;
+            fresh.data.resize(line_bytes, 0);
+            fresh.valid.resize(line_bytes, false);
+            lines.push_back(fresh);
+            line = &lines.back();
+            combined = false;
+        }
+        
+        line->data[byte_addr - line_addr] = (data >> (i * 8)) & 0xFF;
+        line->valid[byte_addr - line_addr] = true;
+    }
+    
+    return combined;
+}
+
+bool StoreBuffer::peek(Address& line_addr) const {
+    if (lines.empty()) {
+        return false;
+    }
+    
+    line_addr = lines.front().line_addr;
+    return true;
+}
+
+bool StoreBuffer::drain(StoreBufferLine& line) {
+    if (drain_wait > 0) {
+        drain_wait--;
+    }
+    
+    if (lines.empty() || drain_wait > 0) {
+        return false;
+    }
+    
+    line = lines.front();
+    lines.pop_front();
+    drain_wait = drain_cycles;
+    return true;
+}
+
+RegisterValue StoreBuffer::forward(Address addr, uint8_t size, RegisterValue memory_data) const {
+    RegisterValue data = memory_data;
+    
+    for (uint8_t i = 0; i < size; i++) {
+        Address byte_addr = addr + i;
+        const StoreBufferLine* line = find_line(line_of(byte_addr));
+        if (line && line->valid[byte_addr - line->line_addr]) {
+            data &= ~(static_cast<RegisterValue>(0xFF) << (i * 8));
+            data |= static_cast<RegisterValue>(line->data[byte_addr - line->line_addr]) << (i * 8);
+        }
+    }
+    
+    return data;
+}
@@ -0,0 +1,78 @@
+#include "execute/store_set_predictor.h"
+#include <algorithm>
+
+StoreSetPredictor::StoreSetPredictor(sc_module_name name, unsigned int ssit_size,
+                                     unsigned int lfst_size, uint64_t clear_interval)
+    : sc_module(name),
+      ssit_entries(ssit_size > 0 ? ssit_size : 1),
+      lfst_entries(lfst_size > 0 ? lfst_size : 1),
+      clear_cycles(clear_interval),
+      cycle(0),
+      next_set(0) {
+    ssit.resize(ssit_entries);
+    lfst.resize(lfst_entries);
+    reset();
+}
+
+void StoreSetPredictor::reset() {
+    std::fill(ssit.begin(), ssit.end(), INVALID_SET);
+    std::fill(lfst.begin(), lfst.end(), 0);
+    next_set = 0;
+    cycle = 0;
+}
+
+void StoreSetPredictor::tick() {
+    cycle++;
+    if (clear_cycles > 0 && cycle % clear_cycles == 0) {
+        std::fill(ssit.begin(), ssit.end(), INVALID_SET);
+        std::fill(lfst.begin(), lfst.end(), 0);
+    }
+}
+
+unsigned int StoreSetPredictor::ssit_index(Address pc) const {
+    return (pc >> 2) % ssit_entries;
+}
+
+uint64_t StoreSetPredictor::predict(Address pc) const {
+    unsigned int set = ssit[ssit_index(pc)];
+    if (set == INVALID_SET) {
+        return 0;
+    }
+    
+    return lfst[set];
+}
+
+void StoreSetPredictor::store_dispatched(Address pc, uint64_t seq) {
+    unsigned int set = ssit[ssit_index(pc)];
+    if (set != INVALID_SET) {
+        lfst[set] = seq;
+    }
+}
+
+void StoreSetPredictor::store_resolved(Address pc, uint64_t seq) {
+    unsigned int set = ssit[ssit_index(pc)];
+    if (set != INVALID_SET && lfst[set] == seq) {
+        lfst[set] = 0;
+    }
+}
+
+void StoreSetPredictor::record_violation(Address load_pc, Address store_pc) {
+    unsigned int &load_set = ssit[ssit_index(load_pc)];
+    unsigned int &store_set = ssit[ssit_index(store_pc)];
+    
+    if (load_set == INVALID_SET && store_set == INVALID_SET) {
+        // Neither belongs to a set yet: start a new one
+        load_set = next_set;
+        store_set = next_set;
+        next_set = (next_set + 1) % lfst_entries;
+    } else if (load_set == INVALID_SET) {
+        load_set = store_set;
+    } else if (store_set == INVALID_SET) {
+        store_set = load_set;
+    } else {
+        // Merge by moving both to the smaller set ID
+        unsigned int merged = std::min(load_set, store_set);
+        load_set = merged;
+        store_set = merged;
+    }
+}
@@ -1,6 +1,20 @@
 #include "fetch/fetch_unit.h"
+#include "common/performance_analyzer.h"
+#include "decode/compressed.h"
+#include <algorithm>
 
-FetchUnit::FetchUnit(sc_module_name name, PredictorType predictor_type) : sc_module(name), pc(0) {
+FetchUnit::FetchUnit(sc_module_name name, PredictorType predictor_type, unsigned int width,
+                     unsigned int line_size, unsigned int ftq_entries)
+    : sc_module(name), pc(0), reset_pc(0), fetch_width(width), xlen(64),
+      ftq_size(ftq_entries > 0 ? ftq_entries : 1),
+      icache_line_size(line_size > 0 ? line_size : 64), current_line(0),
+      current_line_valid(false), spanned_line(0), spanned_line_valid(false),
+      icache_wait(0), uop_cache(nullptr), uop_width(0), uop_switch_penalty(0),
+      uop_active(false), switch_wait(0), perf(nullptr) {
+    // Clamp the fetch width to what the fetch/decode channel can carry
+    if (fetch_width == 0) fetch_width = 1;
+    if (fetch_width > MAX_PIPELINE_WIDTH) fetch_width = MAX_PIPELINE_WIDTH;
+    
     // Create branch predictor as a proper SystemC child module
     branch_predictor = new BranchPredictor("branch_predictor", predictor_type);
     
@@ -22,37 +36,261 @@ FetchUnit::~FetchUnit() {
     delete branch_predictor;
 }
 
+void FetchUnit::set_uop_cache(UopCache* cache, unsigned int width, unsigned int switch_penalty) {
+    uop_cache = cache;
+    uop_width = std::min(std::max(width, 1u), MAX_PIPELINE_WIDTH);
+    uop_switch_penalty = switch_penalty;
+}
+
 void FetchUnit::fetch_proc() {
     if (reset.read()) {
-        // Reset the PC and output an invalid packet
-        pc = 0;
-        FetchPacket empty_packet;
-        empty_packet.valid = false;
-        fetch_out.write(empty_packet);
+        // Reset the PC and output an empty bundle
+        pc = reset_pc;
+        ftq.clear();
+        current_line_valid = false;
+        spanned_line_valid = false;
+        icache_wait = 0;
+        uop_active = false;
+        switch_wait = 0;
+        FetchBundle empty_bundle;
+        empty_bundle.count = 0;
+        fetch_out.write(empty_bundle);
+        DecodeBundle empty_uops;
+        empty_uops.count = 0;
+        uop_out.write(empty_uops);
+        return;
+    }
+    
+    bool redirect = branch_taken.read();
+    if (redirect) {
+        // The back end resolved a misprediction: restart prediction at the
+        // correct PC. Queued blocks and any outstanding line fill were for
+        // the wrong path.
+        pc = branch_target.read();
+        ftq.clear();
+        icache_wait = 0;
+        switch_wait = 0;
+    }
+    
+    // The predictor runs ahead whenever the queue has room, and queued
+    // blocks prefetch their lines. The micro-op cache can consume two
+    // blocks a cycle, so the predictor keeps pace with it.
+    predict_block();
+    if (uop_cache) {
+        predict_block();
+    }
+    prefetch_blocks();
+    
+    // Blocks that hit in the micro-op cache bypass the instruction cache
+    // and decode; this goes out every cycle, empty unless we deliver
+    DecodeBundle uops;
+    uops.count = 0;
+    
+    if (redirect) {
+        // Whatever we were holding for decode is on the wrong path
+        FetchBundle bundle;
+        bundle.count = 0;
+        if (!stall.read() && !fetch_uops(uops)) {
+            fetch_group(bundle);
+        }
+        fetch_out.write(bundle);
+    } else if (icache_wait > 0) {
+        // Waiting on an instruction cache miss; nothing to deliver
+        icache_wait--;
+        if (!stall.read()) {
+            FetchBundle bundle;
+            bundle.count = 0;
+            fetch_out.write(bundle);
+        }
     } else if (!stall.read()) {
-        // Check if branch prediction is active
-        if (branch_taken.read()) {
-            pc = branch_target.read();
+        FetchBundle bundle;
+        bundle.count = 0;
+        if (!fetch_uops(uops)) {
+            fetch_group(bundle);
         }
         
-        // Fetch instruction from memory
-        Instruction inst = mem_interface->read_instruction(pc);
+        // Write output
+        fetch_out.write(bundle);
+    }
+    uop_out.write(uops);
+    
+    if (perf) {
+        perf->record_ftq_occupancy(static_cast<unsigned int>(ftq.size()), ftq_size);
+    }
+}
+
+void FetchUnit::predict_block() {
+    if (ftq.size() >= ftq_size) {
+        return;
+    }
+    
+    // Walk sequential instructions until a predicted-taken control transfer,
+    // the fetch width or the end of the line. Instructions are pre-decoded
+    // from memory, standing in for a branch target buffer.
+    FetchBlock block;
+    block.start_pc = pc;
+    block.count = 0;
+    block.prefetched = false;
+    
+    Address line = line_of(pc);
+    Address block_pc = pc;
+    Address next_pc = pc;
+    while (block.count < fetch_width) {
+        Instruction inst = mem_interface->read_instruction(block_pc);
+        next_pc = predict_next_pc(block_pc, inst);
+        block.end_pc = block_pc + instruction_length(inst);
+        block.count++;
+        
+        bool sequential = (next_pc == block.end_pc);
+        if (!sequential || line_of(next_pc) != line) {
+            break;
+        }
+        block_pc = next_pc;
+    }
+    
+    block.next_pc = next_pc;
+    pc = next_pc;
+    ftq.push_back(block);
+}
+
+void FetchUnit::prefetch_blocks() {
+    // The head block is fetched (or waited on) directly; request the line of
+    // the oldest queued block behind it that has not been prefetched yet
+    for (size_t i = 1; i < ftq.size(); i++) {
+        FetchBlock &block = ftq[i];
+        if (block.prefetched) {
+            continue;
+        }
         
-        // Create fetch packet
-        FetchPacket packet;
-        packet.instruction = inst;
-        packet.pc = pc;
+        block.prefetched = true;
+        Address line = line_of(block.start_pc);
+        if (!current_line_valid || line != current_line) {
+            mem_interface->prefetch_instruction(block.start_pc);
+        }
+        break;
+    }
+}
+
+void FetchUnit::fetch_group(FetchBundle& bundle) {
+    if (ftq.empty()) {
+        return;
+    }
+    
+    // Look up the instruction cache when fetch enters a new line. A block
+    // whose last instruction straddles the line boundary needs the next
+    // line as well; both are read together. On a miss the block waits at
+    // the head of the queue until the lines arrive.
+    const FetchBlock &block = ftq.front();
+    Address line = line_of(block.start_pc);
+    Address last_line = line_of(block.end_pc - 1);
+    bool buffered = current_line_valid && last_line == current_line &&
+                    (line == last_line || (spanned_line_valid && spanned_line == line));
+    if (!buffered) {
+        current_line = last_line;
+        current_line_valid = true;
+        spanned_line = line;
+        spanned_line_valid = (line != last_line);
+        
+        unsigned int latency = mem_interface->access_instruction(block.start_pc);
+        if (line != last_line) {
+            latency = std::max(latency, mem_interface->access_instruction(last_line));
+        }
+        if (latency > 1) {
+            icache_wait = latency - 1;
+            return;
+        }
+    }
+    
+    // Deliver the block; only its last instruction can be predicted taken
+    Address fetch_pc = block.start_pc;
+    unsigned int compressed = 0;
+    for (unsigned int i = 0; i < block.count; i++) {
+        FetchPacket& packet = bundle.packets[bundle.count++];
+        packet.instruction = mem_interface->read_instruction(fetch_pc);
+        unsigned int length = instruction_length(packet.instruction);
+        if (length == 2) {
+            // Drop the halfword that belongs to the next instruction
+            packet.instruction &= 0xFFFF;
+            compressed++;
+        }
+        packet.pc = fetch_pc;
+        packet.predicted_pc = (i + 1 == block.count) ? block.next_pc : fetch_pc + length;
         packet.valid = true;
+        fetch_pc += length;
+    }
+    
+    if (perf) {
+        perf->record_fetch_block(block.count, compressed, static_cast<unsigned int>(block.end_pc - block.start_pc));
+        if (uop_cache) {
+            perf->record_uop_lookup(false);
+        }
+    }
+    
+    ftq.pop_front();
+}
+
+bool FetchUnit::fetch_uops(DecodeBundle& bundle) {
+    // Returns false when the head block goes down the instruction cache and
+    // decode path instead
+    if (!uop_cache || ftq.empty()) {
+        return false;
+    }
+    
+    if (switch_wait > 0) {
+        switch_wait--;
+        return true;
+    }
+    
+    // Moving between the micro-op cache and the decoders takes time to
+    // steer the front end the other way
+    bool hit = uop_cache->lookup(ftq.front().start_pc, ftq.front().end_pc) != nullptr;
+    if (hit != uop_active) {
+        uop_active = hit;
+        if (perf) {
+            perf->record_uop_switch(uop_switch_penalty);
+        }
+        if (uop_switch_penalty > 0) {
+            switch_wait = uop_switch_penalty - 1;
+            return true;
+        }
+    }
+    if (!hit) {
+        return false;
+    }
+    
+    // Deliver up to two consecutive blocks that hit, within the delivery
+    // width. The packets were decoded for the same block boundaries, so
+    // only the last one's predicted successor can differ.
+    unsigned int instructions = 0;
+    for (unsigned int blocks = 0; blocks < 2 && !ftq.empty(); blocks++) {
+        const FetchBlock &block = ftq.front();
+        const UopCacheEntry* entry = uop_cache->lookup(block.start_pc, block.end_pc);
+        if (!entry || (bundle.count > 0 && bundle.count + entry->count > uop_width)) {
+            break;
+        }
         
-        // Write output
-        fetch_out.write(packet);
+        for (uint8_t i = 0; i < entry->count; i++) {
+            bundle.packets[bundle.count++] = entry->packets[i];
+            instructions += (entry->packets[i].fusion != FusionKind::NONE) ? 2 : 1;
+        }
+        bundle.packets[bundle.count - 1].predicted_pc = block.next_pc;
         
-        // Update PC for next cycle
-        pc = predict_next_pc(pc, inst);
+        if (perf) {
+            perf->record_uop_lookup(true);
+        }
+        ftq.pop_front();
     }
+    
+    if (perf) {
+        perf->record_uop_delivery(bundle.count, instructions);
+    }
+    return true;
 }
 
-Address FetchUnit::predict_next_pc(Address current_pc, Instruction inst) {
+Address FetchUnit::predict_next_pc(Address current_pc, Instruction raw) {
+    // Predecode compressed instructions in their expanded form
+    Instruction inst = expand_instruction(raw, xlen);
+    
     // Extract opcode
     uint32_t opcode = inst & 0x7F;
     
@@ -89,7 +327,7 @@ Address FetchUnit::predict_next_pc(Address current_pc, Instruction inst) {
     }
     
     // Default prediction: next sequential instruction
-    return current_pc + 4;
+    return current_pc + instruction_length(raw);
 }
 
 // Methods to retrieve branch predictor statistics
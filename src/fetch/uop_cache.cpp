@@ -0,0 +1,67 @@
+#include "fetch/uop_cache.h"
+
+UopCache::UopCache(sc_module_name name, const UopCacheConfig& config)
+    : sc_module(name), use_counter(0) {
+    unsigned int total = config.entries > 0 ? config.entries : 1;
+    num_ways = config.ways > 0 && config.ways <= total ? config.ways : total;
+    num_sets = total / num_ways;
+    
+    entries.resize(num_sets * num_ways);
+    reset();
+}
+
+void UopCache::reset() {
+    for (auto &entry : entries) {
+        entry.valid = false;
+    }
+}
+
+const UopCacheEntry* UopCache::lookup(Address start_pc, Address end_pc) {
+    UopCacheEntry* set = set_of(start_pc);
+    for (unsigned int way = 0; way < num_ways; way++) {
+        if (set[way].valid && set[way].start_pc == start_pc && set[way].end_pc == end_pc) {
+            set[way].last_use = ++use_counter;
+            return &set[way];
+        }
+    }
+    
+    return nullptr;
+}
+
+void UopCache::insert(Address start_pc, Address end_pc, const DecodeBundle& bundle) {
+    if (bundle.count == 0) {
+        return;
+    }
+    
+    // Refill the entry of a block that now ends elsewhere; otherwise prefer
+    // an invalid way, then the least recently used
+    UopCacheEntry* set = set_of(start_pc);
+    UopCacheEntry* victim = nullptr;
+    for (unsigned int way = 0; way < num_ways; way++) {
+        if (set[way].valid && set[way].start_pc == start_pc) {
+            victim = &set[way];
+            break;
+        }
+    }
+    if (!victim) {
+        victim = &set[0];
+        for (unsigned int way = 0; way < num_ways; way++) {
+            if (!set[way].valid) {
+                victim = &set[way];
+                break;
+            }
+            if (set[way].last_use < victim->last_use) {
+                victim = &set[way];
+            }
+        }
+    }
+    
+    victim->valid = true;
+    victim->start_pc = start_pc;
+    victim->end_pc = end_pc;
+    victim->count = bundle.count;
+    for (uint8_t i = 0; i < bundle.count; i++) {
+        victim->packets[i] = bundle.packets[i];
+    }
+    victim->last_use = ++use_counter;
+}
@@ -3,6 +3,23 @@
 #include <string>
 #include "processor.h"
 
+// Opcode named on the command line (lowercase major opcode names)
+static bool parse_opcode(const std::string& name, Opcode& opcode) {
+    static const std::pair<const char*, Opcode> names[] = {
+        {"lui", Opcode::LUI}, {"auipc", Opcode::AUIPC}, {"jal", Opcode::JAL},
+        {"jalr", Opcode::JALR}, {"branch", Opcode::BRANCH}, {"load", Opcode::LOAD},
+        {"store", Opcode::STORE}, {"op_imm", Opcode::OP_IMM}, {"op", Opcode::OP},
+        {"system", Opcode::SYSTEM}, {"op_imm_32", Opcode::OP_IMM_32}, {"op_32", Opcode::OP_32}
+    };
+    for (const auto& entry : names) {
+        if (name == entry.first) {
+            opcode = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
+
 int sc_main(int argc, char* argv[]) {
     // Parse command line arguments
     std::string program_file = "program.bin";
@@ -11,6 +28,7 @@ int sc_main(int argc, char* argv[]) {
     std::string report_file = "performance_report.txt";
     std::string csv_file = "performance_data.csv";
     std::string predictor_type = "two_bit"; // Default predictor
+    ProcessorConfig config;
     
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -20,6 +38,212 @@ int sc_main(int argc, char* argv[]) {
             simulation_time = std::stoull(argv[++i]);
         } else if (arg == "-p" && i + 1 < argc) {
             predictor_type = argv[++i];
+        } else if (arg == "-w" && i + 1 < argc) {
+            config.pipeline_width = std::stoul(argv[++i]);
+        } else if (arg == "--ftq-size" && i + 1 < argc) {
+            config.ftq_size = std::stoul(argv[++i]);
+        } else if (arg == "--fusion" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "on") {
+                config.macro_fusion = true;
+            } else if (mode == "off") {
+                config.macro_fusion = false;
+            } else {
+                std::cerr << "Warning: Unknown fusion mode '" << mode
+                          << "'. Using default (off)." << std::endl;
+            }
+        } else if (arg == "--uop-cache" && i + 1 < argc) {
+            config.uop_cache.entries = std::stoul(argv[++i]);
+        } else if (arg == "--uop-ways" && i + 1 < argc) {
+            config.uop_cache.ways = std::stoul(argv[++i]);
+        } else if (arg == "--uop-width" && i + 1 < argc) {
+            config.uop_cache.width = std::stoul(argv[++i]);
+        } else if (arg == "--uop-switch" && i + 1 < argc) {
+            config.uop_cache.switch_penalty = std::stoul(argv[++i]);
+        } else if (arg == "--commit-width" && i + 1 < argc) {
+            config.commit_width = std::stoul(argv[++i]);
+        } else if (arg == "--rob-size" && i + 1 < argc) {
+            config.rob_size = std::stoul(argv[++i]);
+        } else if (arg == "--lq-size" && i + 1 < argc) {
+            config.load_queue_size = std::stoul(argv[++i]);
+        } else if (arg == "--sq-size" && i + 1 < argc) {
+            config.store_queue_size = std::stoul(argv[++i]);
+        } else if (arg == "--store-buffer" && i + 1 < argc) {
+            config.store_buffer_size = std::stoul(argv[++i]);
+        } else if (arg == "--store-drain" && i + 1 < argc) {
+            config.store_buffer_drain_interval = std::stoul(argv[++i]);
+        } else if (arg == "--mem-dep" && i + 1 < argc) {
+            std::string policy = argv[++i];
+            if (policy == "conservative") {
+                config.mem_dep_policy = MemDepPolicy::CONSERVATIVE;
+            } else if (policy == "speculative") {
+                config.mem_dep_policy = MemDepPolicy::SPECULATIVE;
+            } else if (policy == "store_sets") {
+                config.mem_dep_policy = MemDepPolicy::STORE_SETS;
+            } else {
+                std::cerr << "Warning: Unknown memory dependence policy '" << policy
+                          << "'. Using default (store_sets)." << std::endl;
+            }
+        } else if (arg == "--value-pred" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "on") {
+                config.value_prediction = true;
+            } else if (mode == "off") {
+                config.value_prediction = false;
+            } else {
+                std::cerr << "Warning: Unknown value prediction mode '" << mode
+                          << "'. Using default (off)." << std::endl;
+            }
+        } else if (arg == "--vp-entries" && i + 1 < argc) {
+            config.lvp_entries = std::stoul(argv[++i]);
+        } else if (arg == "--vp-confidence" && i + 1 < argc) {
+            config.lvp_confidence = std::stoul(argv[++i]);
+        } else if (arg == "--rename" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "merged") {
+                config.rename_mode = RenameMode::MERGED;
+            } else if (mode == "rob") {
+                config.rename_mode = RenameMode::ROB;
+            } else {
+                std::cerr << "Warning: Unknown rename mode '" << mode
+                          << "'. Using default (rob)." << std::endl;
+            }
+        } else if (arg == "--move-elim" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "on") {
+                config.rename_elimination = true;
+            } else if (mode == "off") {
+                config.rename_elimination = false;
+            } else {
+                std::cerr << "Warning: Unknown move elimination mode '" << mode
+                          << "'. Using default (off)." << std::endl;
+            }
+        } else if (arg == "--phys-regs" && i + 1 < argc) {
+            config.num_phys_regs = std::stoul(argv[++i]);
+        } else if (arg == "--checkpoints" && i + 1 < argc) {
+            config.rat_checkpoints = std::stoul(argv[++i]);
+        } else if (arg == "--alus" && i + 1 < argc) {
+            config.alu_units.count = std::stoul(argv[++i]);
+        } else if (arg == "--agus" && i + 1 < argc) {
+            config.agu_units.count = std::stoul(argv[++i]);
+        } else if (arg == "--branch-units" && i + 1 < argc) {
+            config.branch_units.count = std::stoul(argv[++i]);
+        } else if (arg == "--mul-latency" && i + 1 < argc) {
+            config.mul_units.latency = std::stoul(argv[++i]);
+        } else if (arg == "--div-latency" && i + 1 < argc) {
+            config.div_units.latency = std::stoul(argv[++i]);
+        } else if (arg == "--latency" && i + 1 < argc) {
+            std::string setting = argv[++i];
+            size_t eq = setting.find('=');
+            Opcode opcode;
+            if (eq == std::string::npos || !parse_opcode(setting.substr(0, eq), opcode)) {
+                std::cerr << "Warning: Unknown opcode latency '" << setting
+                          << "'. Expected <opcode>=<cycles>." << std::endl;
+            } else {
+                config.opcode_latency[opcode] = std::stoul(setting.substr(eq + 1));
+            }
+        } else if (arg == "--select" && i + 1 < argc) {
+            std::string policy = argv[++i];
+            if (policy == "oldest") {
+                config.select_policy = SelectPolicy::OLDEST_FIRST;
+            } else if (policy == "loads_first") {
+                config.select_policy = SelectPolicy::LOADS_FIRST;
+            } else if (policy == "critical_path") {
+                config.select_policy = SelectPolicy::CRITICAL_PATH;
+            } else {
+                std::cerr << "Warning: Unknown select policy '" << policy
+                          << "'. Using default (oldest)." << std::endl;
+            }
+        } else if (arg == "--l1i-size" && i + 1 < argc) {
+            config.l1i.size = std::stoul(argv[++i]);
+        } else if (arg == "--l1d-size" && i + 1 < argc) {
+            config.l1d.size = std::stoul(argv[++i]);
+        } else if (arg == "--l1-ways" && i + 1 < argc) {
+            config.l1i.ways = config.l1d.ways = std::stoul(argv[++i]);
+        } else if (arg == "--l1-line" && i + 1 < argc) {
+            config.l1i.line_size = config.l1d.line_size = std::stoul(argv[++i]);
+        } else if (arg == "--l1-replacement" && i + 1 < argc) {
+            std::string policy = argv[++i];
+            if (policy == "lru") {
+                config.l1i.replacement = config.l1d.replacement = ReplacementPolicy::LRU;
+            } else if (policy == "plru") {
+                config.l1i.replacement = config.l1d.replacement = ReplacementPolicy::PLRU;
+            } else if (policy == "rrip") {
+                config.l1i.replacement = config.l1d.replacement = ReplacementPolicy::RRIP;
+            } else {
+                std::cerr << "Warning: Unknown replacement policy '" << policy
+                          << "'. Using default (lru)." << std::endl;
+            }
+        } else if (arg == "--l1d-latency" && i + 1 < argc) {
+            config.l1d.hit_latency = std::stoul(argv[++i]);
+        } else if (arg == "--l1i-mshrs" && i + 1 < argc) {
+            config.l1i.mshrs = std::stoul(argv[++i]);
+        } else if (arg == "--l1d-mshrs" && i + 1 < argc) {
+            config.l1d.mshrs = std::stoul(argv[++i]);
+        } else if (arg == "--l2-size" && i + 1 < argc) {
+            config.l2.size = std::stoul(argv[++i]);
+        } else if (arg == "--l2-ways" && i + 1 < argc) {
+            config.l2.ways = std::stoul(argv[++i]);
+        } else if (arg == "--l2-latency" && i + 1 < argc) {
+            config.l2.hit_latency = std::stoul(argv[++i]);
+        } else if (arg == "--l2-mshrs" && i + 1 < argc) {
+            config.l2.mshrs = std::stoul(argv[++i]);
+        } else if ((arg == "--l1d-prefetch" || arg == "--l2-prefetch") && i + 1 < argc) {
+            std::string name = argv[++i];
+            PrefetcherType type = PrefetcherType::NONE;
+            if (name == "next_line") {
+                type = PrefetcherType::NEXT_LINE;
+            } else if (name == "stride") {
+                type = PrefetcherType::STRIDE;
+            } else if (name == "stream") {
+                type = PrefetcherType::STREAM;
+            } else if (name != "none") {
+                std::cerr << "Warning: Unknown prefetcher '" << name
+                          << "'. Using default (none)." << std::endl;
+            }
+            if (arg == "--l1d-prefetch") {
+                config.l1d_prefetcher = type;
+            } else {
+                config.l2_prefetcher = type;
+            }
+        } else if (arg == "--prefetch-degree" && i + 1 < argc) {
+            config.prefetch_degree = std::stoul(argv[++i]);
+        } else if (arg == "--dram-banks" && i + 1 < argc) {
+            config.dram.banks = std::stoul(argv[++i]);
+        } else if (arg == "--dram-queue" && i + 1 < argc) {
+            config.dram.queue_size = std::stoul(argv[++i]);
+        } else if (arg == "--dram-trcd" && i + 1 < argc) {
+            config.dram.t_rcd = std::stoul(argv[++i]);
+        } else if (arg == "--dram-tcas" && i + 1 < argc) {
+            config.dram.t_cas = std::stoul(argv[++i]);
+        } else if (arg == "--dram-trp" && i + 1 < argc) {
+            config.dram.t_rp = std::stoul(argv[++i]);
+        } else if (arg == "--vm" && i + 1 < argc) {
+            std::string pages = argv[++i];
+            config.virtual_memory = true;
+            if (pages == "4k") {
+                config.page_shift = 12;
+            } else if (pages == "2m") {
+                config.page_shift = 21;
+            } else if (pages == "1g") {
+                config.page_shift = 30;
+            } else {
+                config.virtual_memory = false;
+                if (pages != "off") {
+                    std::cerr << "Warning: Unknown page size '" << pages
+                              << "'. Using default (off)." << std::endl;
+                }
+            }
+        } else if (arg == "--itlb-entries" && i + 1 < argc) {
+            config.itlb.entries = std::stoul(argv[++i]);
+        } else if (arg == "--dtlb-entries" && i + 1 < argc) {
+            config.dtlb.entries = std::stoul(argv[++i]);
+        } else if (arg == "--l2tlb-entries" && i + 1 < argc) {
+            config.l2tlb.entries = std::stoul(argv[++i]);
+        } else if (arg == "--l2tlb-latency" && i + 1 < argc) {
+            config.l2tlb.hit_latency = std::stoul(argv[++i]);
+        } else if (arg == "--pwc-entries" && i + 1 < argc) {
+            config.pwc_entries = std::stoul(argv[++i]);
         } else if (arg == "-r") {
             generate_report = true;
         } else if (arg == "-o" && i + 1 < argc) {
@@ -29,11 +253,68 @@ int sc_main(int argc, char* argv[]) {
         } else if (arg == "-h" || arg == "--help") {
             std::cout << "Usage: " << argv[0] << " [options]" << std::endl;
             std::cout << "Options:" << std::endl;
-            std::cout << "  -f <file>    Program binary file (default: program.bin)" << std::endl;
+            std::cout << "  -f <file>    Program ELF executable or raw binary (default: program.bin)" << std::endl;
             std::cout << "  -t <time>    Simulation time in ns (default: 1000)" << std::endl;
             std::cout << "  -p <type>    Branch predictor type (default: two_bit)" << std::endl;
             std::cout << "               Supported types: always_not_taken, always_taken, static_btfn," << std::endl;
             std::cout << "               one_bit, two_bit, gshare, tournament" << std::endl;
+            std::cout << "  -w <width>   Fetch/decode/dispatch width (default: 4, max: " << MAX_PIPELINE_WIDTH << ")" << std::endl;
+            std::cout << "  --ftq-size <n>      Fetch target queue entries (default: 8)" << std::endl;
+            std::cout << "  --fusion <on|off>   Macro-op fusion of adjacent instruction pairs (default: off)" << std::endl;
+            std::cout << "  --uop-cache <n>     Micro-op cache entries in fetch blocks, 0 for none (default: 0)" << std::endl;
+            std::cout << "  --uop-ways <n>      Micro-op cache associativity (default: 8)" << std::endl;
+            std::cout << "  --uop-width <n>     Micro-op cache packets delivered per cycle (default: 6)" << std::endl;
+            std::cout << "  --uop-switch <n>    Cycles lost switching to or from the micro-op cache (default: 1)" << std::endl;
+            std::cout << "  --commit-width <n>  Instructions retired per cycle (default: 4)" << std::endl;
+            std::cout << "  --rob-size <n>      Reorder buffer entries (default: 16)" << std::endl;
+            std::cout << "  --lq-size <n>       Load queue entries (default: 8)" << std::endl;
+            std::cout << "  --sq-size <n>       Store queue entries (default: 8)" << std::endl;
+            std::cout << "  --store-buffer <n>  Post-commit store buffer lines (default: 8)" << std::endl;
+            std::cout << "  --store-drain <n>   Cycles between store buffer line writes (default: 1)" << std::endl;
+            std::cout << "  --mem-dep <policy>  Load/store ordering: conservative, speculative, store_sets" << std::endl;
+            std::cout << "                      (default: store_sets)" << std::endl;
+            std::cout << "  --value-pred <on|off> Last-value/stride load value prediction (default: off)" << std::endl;
+            std::cout << "  --vp-entries <n>    Load value predictor entries (default: 1024)" << std::endl;
+            std::cout << "  --vp-confidence <n> Repeated strides before predicting, 0-7 (default: 7)" << std::endl;
+            std::cout << "  --rename <mode>     Register renaming: rob, merged (default: rob)" << std::endl;
+            std::cout << "  --move-elim <on|off> Resolve moves and zero idioms at rename (default: off)" << std::endl;
+            std::cout << "  --phys-regs <n>     Physical registers in merged mode (default: 64)" << std::endl;
+            std::cout << "  --checkpoints <n>   Rename map checkpoints in merged mode (default: 8)" << std::endl;
+            std::cout << "  --alus <n>          Integer ALUs (default: 3)" << std::endl;
+            std::cout << "  --agus <n>          Address generation units (default: 2)" << std::endl;
+            std::cout << "  --branch-units <n>  Branch units (default: 1)" << std::endl;
+            std::cout << "  --mul-latency <n>   Pipelined multiplier latency (default: 3)" << std::endl;
+            std::cout << "  --div-latency <n>   Worst-case iterative divider latency (default: 20)" << std::endl;
+            std::cout << "  --latency <op>=<n>  Latency of one opcode: lui, auipc, jal, jalr, branch, load," << std::endl;
+            std::cout << "                      store, op_imm, op, system, op_imm_32, op_32 (repeatable)" << std::endl;
+            std::cout << "  --select <policy>   Issue select policy: oldest, loads_first, critical_path" << std::endl;
+            std::cout << "                      (default: oldest)" << std::endl;
+            std::cout << "  --l1i-size <bytes>  L1 instruction cache capacity (default: 32768)" << std::endl;
+            std::cout << "  --l1d-size <bytes>  L1 data cache capacity (default: 32768)" << std::endl;
+            std::cout << "  --l1-ways <n>       L1 associativity (default: 8)" << std::endl;
+            std::cout << "  --l1-line <bytes>   L1 line size (default: 64)" << std::endl;
+            std::cout << "  --l1-replacement <policy>  L1 replacement: lru, plru, rrip (default: lru)" << std::endl;
+            std::cout << "  --l1d-latency <n>   L1 data cache hit latency (default: 2)" << std::endl;
+            std::cout << "  --l1i-mshrs <n>     L1 instruction cache outstanding misses (default: 4)" << std::endl;
+            std::cout << "  --l1d-mshrs <n>     L1 data cache outstanding misses (default: 8)" << std::endl;
+            std::cout << "  --l2-size <bytes>   Shared L2 capacity (default: 262144)" << std::endl;
+            std::cout << "  --l2-ways <n>       L2 associativity (default: 8)" << std::endl;
+            std::cout << "  --l2-latency <n>    L2 hit latency (default: 12)" << std::endl;
+            std::cout << "  --l2-mshrs <n>      L2 outstanding misses (default: 16)" << std::endl;
+            std::cout << "  --l1d-prefetch <type>  L1D prefetcher: none, next_line, stride, stream (default: none)" << std::endl;
+            std::cout << "  --l2-prefetch <type>   L2 prefetcher: none, next_line, stride, stream (default: none)" << std::endl;
+            std::cout << "  --prefetch-degree <n>  Lines requested per prefetch trigger (default: 2)" << std::endl;
+            std::cout << "  --dram-banks <n>    DRAM banks (default: 8)" << std::endl;
+            std::cout << "  --dram-queue <n>    DRAM controller request queue entries (default: 16)" << std::endl;
+            std::cout << "  --dram-trcd <n>     DRAM activate-to-column cycles (default: 14)" << std::endl;
+            std::cout << "  --dram-tcas <n>     DRAM column-to-data cycles (default: 14)" << std::endl;
+            std::cout << "  --dram-trp <n>      DRAM precharge cycles (default: 14)" << std::endl;
+            std::cout << "  --vm <pages>        Sv39 translation with 4k, 2m or 1g pages, or off (default: off)" << std::endl;
+            std::cout << "  --itlb-entries <n>  L1 instruction TLB entries (default: 32)" << std::endl;
+            std::cout << "  --dtlb-entries <n>  L1 data TLB entries (default: 64)" << std::endl;
+            std::cout << "  --l2tlb-entries <n> Unified L2 TLB entries (default: 1024)" << std::endl;
+            std::cout << "  --l2tlb-latency <n> L2 TLB hit latency (default: 7)" << std::endl;
+            std::cout << "  --pwc-entries <n>   Page walk cache entries (default: 16)" << std::endl;
             std::cout << "  -r           Generate detailed performance report" << std::endl;
             std::cout << "  -o <file>    Performance report output file (default: performance_report.txt)" << std::endl;
             std::cout << "  -c <file>    Export performance data to CSV (default: performance_data.csv)" << std::endl;
@@ -69,14 +350,16 @@ int sc_main(int argc, char* argv[]) {
     sc_signal<bool> reset;
     
     // Create the top-level processor module with the selected branch predictor
-    Processor processor("processor", pred_type);
+    Processor processor("processor", pred_type, config);
     
     // Connect clock and reset
     processor.clk(clock);
     processor.reset(reset);
     
     // Load program
-    processor.load_program(program_file);
+    if (!processor.load_program(program_file)) {
+        return 1;
+    }
     
     // Start simulation
     std::cout << "Starting simulation..." << std::endl;
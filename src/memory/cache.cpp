@@ -0,0 +1,228 @@
+#include "memory/cache.h"
+
+// Maximum re-reference prediction value for 2-bit SRRIP
+static const uint8_t RRPV_MAX = 3;
+
+Cache::Cache(sc_module_name name, const CacheConfig& config)
+    : sc_module(name),
+      line_size(config.line_size >= 4 ? config.line_size : 4),
+      hit_latency(config.hit_latency > 0 ? config.hit_latency : 1),
+      policy(config.replacement),
+      access_count(0) {
+    num_ways = config.ways > 0 ? config.ways : 1;
+    num_sets = config.size / (line_size * num_ways);
+    if (num_sets == 0) num_sets = 1;
+    
+    // Tree PLRU needs a power-of-two number of ways
+    if (policy == ReplacementPolicy::PLRU && (num_ways & (num_ways - 1)) != 0) {
+        policy = ReplacementPolicy::LRU;
+    }
+    
+    lines.resize(num_sets * num_ways);
+    plru_bits.resize(num_sets * (num_ways > 1 ? num_ways - 1 : 1));
+    
+    reset();
+}
+
+void Cache::reset() {
+    for (auto &line : lines) {
+        line.valid = false;
+        line.dirty = false;
+        line.prefetched = false;
+        line.tag = 0;
+        line.last_use = 0;
+        line.rrpv = RRPV_MAX;
+    }
+    
+    for (size_t i = 0; i < plru_bits.size(); i++) {
+        plru_bits[i] = false;
+    }
+    
+    access_count = 0;
+}
+
+unsigned int Cache::set_index(Address addr) const {
+    return (addr / line_size) % num_sets;
+}
+
+Address Cache::tag_of(Address addr) const {
+    return addr / line_size / num_sets;
+}
+
+int Cache::find_way(Address addr) const {
+    unsigned int set = set_index(addr);
+    Address tag = tag_of(addr);
+    
+    for (unsigned int way = 0; way < num_ways; way++) {
+        const CacheLine &line = lines[set * num_ways + way];
+        if (line.valid && line.tag == tag) {
+            return static_cast<int>(way);
+        }
+    }
+    
+    return -1;
+}
+
+bool Cache::probe(Address addr) const {
+    return find_way(addr) >= 0;
+}
+
+unsigned int Cache::allocate(Address addr, CacheEviction& eviction) {
+    unsigned int set = set_index(addr);
+    unsigned int way = choose_victim(set);
+    CacheLine &line = lines[set * num_ways + way];
+    
+    if (line.valid) {
+        eviction.valid = true;
+        eviction.dirty = line.dirty;
+        eviction.unused_prefetch = line.prefetched;
+        eviction.line_addr = (line.tag * num_sets + set) * line_size;
+    }
+    
+    line.valid = true;
+    line.dirty = false;
+    line.prefetched = false;
+    line.tag = tag_of(addr);
+    touch(set, way, true);
+    
+    return way;
+}
+
+bool Cache::access(Address addr, bool is_write, CacheEviction& eviction) {
+    unsigned int set = set_index(addr);
+    eviction.valid = false;
+    eviction.dirty = false;
+    eviction.unused_prefetch = false;
+    eviction.line_addr = 0;
+    access_count++;
+    
+    int hit_way = find_way(addr);
+    if (hit_way >= 0) {
+        if (is_write) {
+            lines[set * num_ways + hit_way].dirty = true;
+        }
+        touch(set, hit_way, false);
+        return true;
+    }
+    
+    // Miss: fill into the victim way
+    unsigned int way = allocate(addr, eviction);
+    lines[set * num_ways + way].dirty = is_write;
+    
+    return false;
+}
+
+void Cache::fill(Address addr, CacheEviction& eviction) {
+    eviction.valid = false;
+    eviction.dirty = false;
+    eviction.unused_prefetch = false;
+    eviction.line_addr = 0;
+    
+    if (probe(addr)) {
+        return;
+    }
+    
+    access_count++;
+    unsigned int way = allocate(addr, eviction);
+    lines[set_index(addr) * num_ways + way].prefetched = true;
+}
+
+bool Cache::consume_prefetch(Address addr) {
+    int way = find_way(addr);
+    if (way < 0) {
+        return false;
+    }
+    
+    CacheLine &line = lines[set_index(addr) * num_ways + way];
+    bool prefetched = line.prefetched;
+    line.prefetched = false;
+    return prefetched;
+}
+
+void Cache::touch(unsigned int set, unsigned int way, bool fill) {
+    CacheLine &line = lines[set * num_ways + way];
+    
+    switch (policy) {
+        case ReplacementPolicy::LRU:
+            line.last_use = access_count;
+            break;
+        
+        case ReplacementPolicy::PLRU: {
+            // Walk from the root, pointing every node away from this way
+            unsigned int node = 0;
+            unsigned int low = 0;
+            unsigned int high = num_ways;
+            while (high - low > 1) {
+                unsigned int mid = (low + high) / 2;
+                bool upper = way >= mid;
+                plru_bits[set * (num_ways - 1) + node] = !upper;
+                node = 2 * node + (upper ? 2 : 1);
+                if (upper) {
+                    low = mid;
+                } else {
+                    high = mid;
+                }
+            }
+            break;
+        }
+        
+        case ReplacementPolicy::RRIP:
+            // Insert with a long re-reference interval, promote on a hit
+            line.rrpv = fill ? RRPV_MAX - 1 : 0;
+            break;
+    }
+}
+
+unsigned int Cache::choose_victim(unsigned int set) {
+    // Fill invalid ways first
+    for (unsigned int way = 0; way < num_ways; way++) {
+        if (!lines[set * num_ways + way].valid) {
+            return way;
+        }
+    }
+    
+    switch (policy) {
+        case ReplacementPolicy::PLRU: {
+            // Follow the bits from the root
+            unsigned int node = 0;
+            unsigned int low = 0;
+            unsigned int high = num_ways;
+            while (high - low > 1) {
+                unsigned int mid = (low + high) / 2;
+                bool upper = plru_bits[set * (num_ways - 1) + node];
+                node = 2 * node + (upper ? 2 : 1);
+                if (upper) {
+                    low = mid;
+                } else {
+                    high = mid;
+                }
+            }
+            return low;
+        }
+        
+        case ReplacementPolicy::RRIP:
+            // Evict the first line predicted to be re-referenced furthest away,
+            // aging the whole set until one qualifies
+            while (true) {
+                for (unsigned int way = 0; way < num_ways; way++) {
+                    if (lines[set * num_ways + way].rrpv >= RRPV_MAX) {
+                        return way;
+                    }
+                }
+                for (unsigned int way = 0; way < num_ways; way++) {
+                    lines[set * num_ways + way].rrpv++;
+                }
+            }
+        
+        case ReplacementPolicy::LRU:
+        default: {
+            unsigned int victim = 0;
+            for (unsigned int way = 1; way < num_ways; way++) {
+                if (lines[set * num_ways + way].last_use < lines[set * num_ways + victim].last_use) {
+                    victim = way;
+                }
+            }
+            return victim;
+        }
+    }
+}
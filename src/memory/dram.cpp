@@ -0,0 +1,69 @@
+#include "memory/dram.h"
+#include <algorithm>
+
+Dram::Dram(sc_module_name name, const DramConfig& config)
+    : sc_module(name), timing(config) {
+    if (timing.banks == 0) timing.banks = 1;
+    if (timing.row_size == 0) timing.row_size = 2048;
+    if (timing.queue_size == 0) timing.queue_size = 1;
+    
+    banks.resize(timing.banks);
+    
+    reset();
+}
+
+void Dram::reset() {
+    for (auto &bank : banks) {
+        bank.row_open = false;
+        bank.open_row = 0;
+        bank.busy_until = 0;
+    }
+    
+    in_flight.clear();
+}
+
+unsigned int Dram::access(Address addr, uint64_t cycle,
+                          RowBufferOutcome& outcome, bool& queued) {
+    // Consecutive rows go to consecutive banks
+    uint64_t row_index = addr / timing.row_size;
+    Bank &bank = banks[row_index % timing.banks];
+    uint64_t row = row_index / timing.banks;
+    
+    // Forget requests that have completed
+    in_flight.erase(std::remove_if(in_flight.begin(), in_flight.end(),
+                                   [cycle](uint64_t done) { return done <= cycle; }),
+                    in_flight.end());
+    
+    // A full queue admits the request when enough older ones have finished
+    uint64_t start = cycle;
+    queued = in_flight.size() >= timing.queue_size;
+    if (queued) {
+        std::vector<uint64_t> pending = in_flight;
+        std::sort(pending.begin(), pending.end());
+        start = pending[pending.size() - timing.queue_size];
+    }
+    
+    start = std::max(start, bank.busy_until);
+    
+    unsigned int command_latency;
+    if (bank.row_open && bank.open_row == row) {
+        outcome = RowBufferOutcome::HIT;
+        command_latency = timing.t_cas;
+    } else if (!bank.row_open) {
+        outcome = RowBufferOutcome::EMPTY;
+        command_latency = timing.t_rcd + timing.t_cas;
+    } else {
+        outcome = RowBufferOutcome::CONFLICT;
+        command_latency = timing.t_rp + timing.t_rcd + timing.t_cas;
+    }
+    
+    // Open-page policy: the row stays open for the next request
+    bank.row_open = true;
+    bank.open_row = row;
+    
+    uint64_t finish = start + command_latency + timing.t_burst;
+    bank.busy_until = finish;
+    in_flight.push_back(finish);
+    
+    return static_cast<unsigned int>(finish - cycle);
+}
@@ -0,0 +1,178 @@
+#include "memory/elf_loader.h"
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <iostream>
+
+ElfLoader::ElfLoader(const std::string& filename)
+    : image(nullptr), image_size(0), elf_class(0), entry_pc(0), loaded_segments(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        // A private writable mapping: guest stores into mapped text pages
+        // get their own copy instead of touching the file
+        void* mapped = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            image = static_cast<uint8_t*>(mapped);
+            image_size = st.st_size;
+        }
+    }
+    close(fd);
+    
+    if (image && image_size >= EI_NIDENT && std::memcmp(image, ELFMAG, SELFMAG) == 0) {
+        if (image[EI_CLASS] == ELFCLASS32 || image[EI_CLASS] == ELFCLASS64) {
+            elf_class = image[EI_CLASS];
+        }
+    }
+}
+
+ElfLoader::~ElfLoader() {
+    if (image) {
+        munmap(image, image_size);
+    }
+}
+
+unsigned int ElfLoader::xlen() const {
+    return elf_class == ELFCLASS32 ? 32 : 64;
+}
+
+bool ElfLoader::load(SparseMemory& memory, SymbolTable& symbols) {
+    if (!image) {
+        return false;
+    }
+    
+    if (elf_class == ELFCLASS32) {
+        return load_elf<Elf32_Ehdr, Elf32_Phdr, Elf32_Shdr, Elf32_Sym>(memory, symbols);
+    }
+    if (elf_class == ELFCLASS64) {
+        return load_elf<Elf64_Ehdr, Elf64_Phdr, Elf64_Shdr, Elf64_Sym>(memory, symbols);
+    }
+    
+    // Raw binary
+    memory.load(0, image, image_size);
+    entry_pc = 0;
+    return true;
+}
+
+template <typename Ehdr, typename Phdr, typename Shdr, typename Sym>
+bool ElfLoader::load_elf(SparseMemory& memory, SymbolTable& symbols) {
+    if (image_size < sizeof(Ehdr)) {
+        return false;
+    }
+    
+    const Ehdr* ehdr = reinterpret_cast<const Ehdr*>(image);
+    if (ehdr->e_ident[EI_DATA] != ELFDATA2LSB) {
+        std::cerr << "Error: Only little-endian ELF files are supported" << std::endl;
+        return false;
+    }
+    if (ehdr->e_type != ET_EXEC) {
+        std::cerr << "Error: ELF file is not a static executable (e_type "
+                  << ehdr->e_type << ")" << std::endl;
+        return false;
+    }
+    if (ehdr->e_machine != EM_RISCV) {
+        std::cerr << "Warning: ELF machine type " << ehdr->e_machine
+                  << " is not RISC-V" << std::endl;
+    }
+    
+    // Program headers: place every loadable segment
+    if (ehdr->e_phentsize != sizeof(Phdr) ||
+        ehdr->e_phoff + static_cast<uint64_t>(ehdr->e_phnum) * sizeof(Phdr) > image_size) {
+        return false;
+    }
+    
+    const Phdr* phdrs = reinterpret_cast<const Phdr*>(image + ehdr->e_phoff);
+    for (unsigned int i = 0; i < ehdr->e_phnum; i++) {
+        const Phdr& ph = phdrs[i];
+        if (ph.p_type != PT_LOAD || ph.p_filesz == 0) {
+            continue;
+        }
+        if (ph.p_offset + ph.p_filesz > image_size) {
+            return false;
+        }
+        
+        // Bytes between p_filesz and p_memsz are .bss; untouched guest
+        // pages already read as zero
+        load_segment(memory, ph.p_vaddr, ph.p_offset, ph.p_filesz, (ph.p_flags & PF_W) != 0);
+        loaded_segments++;
+    }
+    
+    entry_pc = ehdr->e_entry;
+    
+    // Section headers: keep the symbol table for profiling. A stripped
+    // binary simply has none.
+    if (ehdr->e_shoff == 0 || ehdr->e_shentsize != sizeof(Shdr) ||
+        ehdr->e_shoff + static_cast<uint64_t>(ehdr->e_shnum) * sizeof(Shdr) > image_size) {
+        return true;
+    }
+    
+    const Shdr* shdrs = reinterpret_cast<const Shdr*>(image + ehdr->e_shoff);
+    for (unsigned int i = 0; i < ehdr->e_shnum; i++) {
+        const Shdr& sh = shdrs[i];
+        if (sh.sh_type != SHT_SYMTAB || sh.sh_link >= ehdr->e_shnum) {
+            continue;
+        }
+        
+        const Shdr& strtab = shdrs[sh.sh_link];
+        if (sh.sh_offset + sh.sh_size > image_size ||
+            strtab.sh_offset + strtab.sh_size > image_size) {
+            continue;
+        }
+        
+        const Sym* syms = reinterpret_cast<const Sym*>(image + sh.sh_offset);
+        const char* names = reinterpret_cast<const char*>(image + strtab.sh_offset);
+        size_t count = sh.sh_size / sizeof(Sym);
+        for (size_t j = 0; j < count; j++) {
+            const Sym& sym = syms[j];
+            unsigned int type = sym.st_info & 0xf;
+            if ((type != STT_FUNC && type != STT_NOTYPE) || sym.st_shndx == SHN_UNDEF ||
+                sym.st_shndx >= SHN_LORESERVE || sym.st_name >= strtab.sh_size) {
+                continue;
+            }
+            
+            // Skip unnamed symbols and assembler-local labels
+            const char* name = names + sym.st_name;
+            if (name[0] == '\0' || name[0] == '$' || std::strncmp(name, ".L", 2) == 0) {
+                continue;
+            }
+            
+            symbols.add(name, sym.st_value, sym.st_size);
+        }
+    }
+    
+    return true;
+}
+
+void ElfLoader::load_segment(SparseMemory& memory, Address vaddr, uint64_t offset,
+                             uint64_t file_size, bool writable) {
+    const uint64_t page_size = SparseMemory::PAGE_SIZE;
+    
+    // Whole pages of a read-only segment can be shared with the mapped file
+    // when file offset and address agree within a page (as the linker lays
+    // them out); the partial pages at either end are copied
+    if (!writable && vaddr % page_size == offset % page_size) {
+        uint64_t head = (page_size - vaddr % page_size) % page_size;
+        if (head < file_size) {
+            memory.load(vaddr, image + offset, head);
+            
+            uint64_t pages = (file_size - head) / page_size;
+            for (uint64_t p = 0; p < pages; p++) {
+                uint64_t delta = head + p * page_size;
+                memory.map(vaddr + delta, image + offset + delta);
+            }
+            
+            uint64_t done = head + pages * page_size;
+            memory.load(vaddr + done, image + offset + done, file_size - done);
+            return;
+        }
+    }
+    
+    memory.load(vaddr, image + offset, file_size);
+}
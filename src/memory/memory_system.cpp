@@ -1,78 +1,448 @@
 #include "memory/memory_system.h"
-#include <fstream>
+#include "common/performance_analyzer.h"
 #include <iostream>
+#include <algorithm>
 
-MemorySystem::MemorySystem(sc_module_name name) : sc_module(name) {
-    // Initialize memory with zeros
-    memory.resize(MEMORY_SIZE, 0);
+MemorySystem::MemorySystem(sc_module_name name, const ProcessorConfig& config)
+    : sc_module(name), program(nullptr), cycle(0), perf_analyzer(nullptr) {
+    // Guest memory reads as zero until written
+    memory = new SparseMemory("memory");
+    
+    // Create the first-level caches
+    l1i = new Cache("l1i", config.l1i);
+    l1d = new Cache("l1d", config.l1d);
+    l1i_mshrs = new MSHRFile("l1i_mshrs", config.l1i.mshrs);
+    l1d_mshrs = new MSHRFile("l1d_mshrs", config.l1d.mshrs);
+    
+    // Create the shared L2 and main memory behind it
+    l2 = new Cache("l2", config.l2);
+    l2_mshrs = new MSHRFile("l2_mshrs", config.l2.mshrs);
+    dram = new Dram("dram", config.dram);
+    
+    // Data prefetchers, if enabled
+    l1d_prefetcher = nullptr;
+    l2_prefetcher = nullptr;
+    if (config.l1d_prefetcher != PrefetcherType::NONE) {
+        l1d_prefetcher = new Prefetcher("l1d_prefetcher", config.l1d_prefetcher,
+                                        config.l1d.line_size, config.prefetch_degree);
+    }
+    if (config.l2_prefetcher != PrefetcherType::NONE) {
+        l2_prefetcher = new Prefetcher("l2_prefetcher", config.l2_prefetcher,
+                                       config.l2.line_size, config.prefetch_degree);
+    }
+    
+    // Sv39 translation, if enabled
+    itlb = nullptr;
+    dtlb = nullptr;
+    l2tlb = nullptr;
+    walker = nullptr;
+    walker_free = 0;
+    if (config.virtual_memory) {
+        itlb = new Tlb("itlb", config.itlb);
+        dtlb = new Tlb("dtlb", config.dtlb);
+        l2tlb = new Tlb("l2tlb", config.l2tlb);
+        walker = new PageTableWalker("walker", memory, config.page_shift, config.pwc_entries);
+    }
     
     // Register process
     SC_METHOD(memory_proc);
     sensitive << clk.pos();
 }
 
+MemorySystem::~MemorySystem() {
+    delete memory;
+    delete program;
+    delete l1i;
+    delete l1d;
+    delete l1i_mshrs;
+    delete l1d_mshrs;
+    delete l2;
+    delete l2_mshrs;
+    delete dram;
+    delete l1d_prefetcher;
+    delete l2_prefetcher;
+    delete itlb;
+    delete dtlb;
+    delete l2tlb;
+    delete walker;
+}
+
 Instruction MemorySystem::read_instruction(Address addr) {
-    if (addr >= MEMORY_SIZE - 3) {
-        std::cerr << "Memory error: Instruction read out of bounds at address 0x" 
-                  << std::hex << addr << std::dec << std::endl;
-        return 0;
+    return static_cast<Instruction>(memory->read(addr, 4));
+}
+
+RegisterValue MemorySystem::read_data(Address addr, uint8_t size) {
+    return memory->read(addr, size);
+}
+
+void MemorySystem::write_data(Address addr, RegisterValue data, uint8_t size) {
+    memory->write(addr, data, size);
+}
+
+unsigned int MemorySystem::access_instruction(Address addr) {
+    unsigned int latency = translate(itlb, "ITLB", addr);
+    return latency + access_cache(l1i, l1i_mshrs, nullptr, "L1I", addr, false, addr, cycle + latency);
+}
+
+unsigned int MemorySystem::access_data(Address addr, bool is_write, Address pc) {
+    unsigned int latency = translate(dtlb, "DTLB", addr);
+    latency += access_cache(l1d, l1d_mshrs, l1d_prefetcher, "L1D", addr, is_write, pc, cycle + latency);
+    if (perf_analyzer) {
+        perf_analyzer->record_data_latency(latency);
+    }
+    return latency;
+}
+
+void MemorySystem::prefetch_instruction(Address addr) {
+    // Instruction prefetches do not start page walks
+    if (itlb) {
+        TlbEntry* entry = itlb->lookup(addr);
+        if (!entry || entry->ready_cycle > cycle) {
+            return;
+        }
     }
     
-    // Little-endian read
-    Instruction inst = 0;
-    inst |= static_cast<Instruction>(memory[addr]);
-    inst |= static_cast<Instruction>(memory[addr + 1]) << 8;
-    inst |= static_cast<Instruction>(memory[addr + 2]) << 16;
-    inst |= static_cast<Instruction>(memory[addr + 3]) << 24;
+    issue_prefetch(l1i, l1i_mshrs, "L1I", l1i->line_address(addr), addr);
+}
+
+bool MemorySystem::can_access_data(Address addr) {
+    Address line = l1d->line_address(addr);
+    if (l1d_mshrs->find(line) || l1d->probe(addr) || l1d_mshrs->has_free()) {
+        return true;
+    }
     
-    return inst;
+    if (perf_analyzer) {
+        perf_analyzer->record_mshr_full("L1D");
+    }
+    return false;
 }
 
-RegisterValue MemorySystem::read_data(Address addr, uint8_t size) {
-    if (addr >= MEMORY_SIZE - (size - 1)) {
-        std::cerr << "Memory error: Data read out of bounds at address 0x" 
-                  << std::hex << addr << std::dec << std::endl;
+unsigned int MemorySystem::translate(Tlb* tlb, const std::string& label, Address addr) {
+    if (!tlb) {
         return 0;
     }
     
-    // Little-endian read
-    RegisterValue data = 0;
-    for (uint8_t i = 0; i < size; i++) {
-        data |= static_cast<RegisterValue>(memory[addr + i]) << (i * 8);
+    // First-level hit; the entry may still be waiting on its walk
+    TlbEntry* entry = tlb->lookup(addr);
+    if (perf_analyzer) {
+        perf_analyzer->record_tlb_access(label, entry != nullptr);
     }
+    if (entry) {
+        uint64_t ready = std::max(entry->ready_cycle, cycle + tlb->get_hit_latency());
+        return static_cast<unsigned int>(ready - cycle);
+    }
+    
+    // Second-level TLB
+    uint64_t start = cycle + tlb->get_hit_latency() + l2tlb->get_hit_latency();
+    entry = l2tlb->lookup(addr);
+    if (perf_analyzer) {
+        perf_analyzer->record_tlb_access("L2TLB", entry != nullptr);
+    }
+    if (entry) {
+        uint64_t ready = std::max(entry->ready_cycle, start);
+        tlb->insert(addr, entry->page_shift, ready);
+        return static_cast<unsigned int>(ready - cycle);
+    }
+    
+    // Page walk. PTE reads are dependent, each goes to the L2 once the
+    // previous one returns; a walk waits for the one before it.
+    start = std::max(start, walker_free);
+    std::vector<Address> pte_reads;
+    unsigned int page_shift = walker->walk(addr, pte_reads);
     
-    return data;
+    uint64_t done = start;
+    for (Address pte : pte_reads) {
+        done += fill_from_l2(pte, done, 0);
+    }
+    walker_free = done;
+    
+    l2tlb->insert(addr, page_shift, done);
+    tlb->insert(addr, page_shift, done);
+    
+    if (perf_analyzer) {
+        perf_analyzer->record_page_walk(static_cast<unsigned int>(pte_reads.size()),
+                                        static_cast<unsigned int>(done - start));
+    }
+    
+    return static_cast<unsigned int>(done - cycle);
 }
 
-void MemorySystem::write_data(Address addr, RegisterValue data, uint8_t size) {
-    if (addr >= MEMORY_SIZE - (size - 1)) {
-        std::cerr << "Memory error: Data write out of bounds at address 0x" 
-                  << std::hex << addr << std::dec << std::endl;
+unsigned int MemorySystem::access_cache(Cache* cache, MSHRFile* mshrs, Prefetcher* prefetcher,
+                                        const std::string& label, Address addr, bool is_write,
+                                        Address pc, uint64_t start) {
+    CacheEviction eviction;
+    
+    // A secondary miss to a line already in flight waits for the same fill.
+    // The tag was installed by the primary miss; touching it updates the
+    // replacement and dirty state.
+    MSHREntry* pending = mshrs->find(cache->line_address(addr));
+    if (pending) {
+        pending->targets++;
+        cache->access(addr, is_write, eviction);
+        
+        // Catching up with an in-flight prefetch: useful, but late
+        bool late_prefetch = pending->prefetch;
+        if (late_prefetch) {
+            pending->prefetch = false;
+            cache->consume_prefetch(addr);
+        }
+        
+        if (perf_analyzer) {
+            perf_analyzer->record_cache_access(label, false);
+            perf_analyzer->record_mshr_merge(label);
+            if (late_prefetch) {
+                perf_analyzer->record_prefetch_useful(label, true);
+            }
+        }
+        write_back(label, eviction);
+        
+        uint64_t remaining = pending->fill_cycle > start ? pending->fill_cycle - start : 0;
+        unsigned int latency = std::max(static_cast<unsigned int>(remaining), cache->get_hit_latency());
+        
+        if (!is_write) {
+            run_prefetcher(prefetcher, cache, mshrs, label, pc, addr, late_prefetch);
+        }
+        return latency;
+    }
+    
+    bool hit = cache->access(addr, is_write, eviction);
+    bool prefetch_hit = hit && cache->consume_prefetch(addr);
+    
+    if (perf_analyzer) {
+        perf_analyzer->record_cache_access(label, hit);
+        if (prefetch_hit) {
+            perf_analyzer->record_prefetch_useful(label, false);
+        }
+    }
+    write_back(label, eviction);
+    
+    unsigned int latency = cache->get_hit_latency();
+    if (!hit) {
+        // A primary miss is sent to the next level once the tag check is done
+        latency += next_level_latency(cache, cache->line_address(addr), start + latency, pc);
+        mshrs->allocate(cache->line_address(addr), start + latency);
+    }
+    
+    // Prefetchers train on loads; misses and first touches of prefetched
+    // lines trigger the sequential schemes
+    if (!is_write) {
+        run_prefetcher(prefetcher, cache, mshrs, label, pc, addr, !hit || prefetch_hit);
+    }
+    
+    return latency;
+}
+
+unsigned int MemorySystem::next_level_latency(Cache* cache, Address line, uint64_t start, Address pc) {
+    if (cache == l2) {
+        return read_dram(line, start);
+    }
+    
+    return fill_from_l2(line, start, pc);
+}
+
+unsigned int MemorySystem::fill_from_l2(Address addr, uint64_t start, Address pc) {
+    CacheEviction eviction;
+    Address line = l2->line_address(addr);
+    
+    // Merge with a fill the L2 already has in flight
+    MSHREntry* pending = l2_mshrs->find(line);
+    if (pending) {
+        pending->targets++;
+        l2->access(line, false, eviction);
+        
+        bool late_prefetch = pending->prefetch;
+        if (late_prefetch) {
+            pending->prefetch = false;
+            l2->consume_prefetch(line);
+        }
+        
+        if (perf_analyzer) {
+            perf_analyzer->record_cache_access("L2", false);
+            perf_analyzer->record_mshr_merge("L2");
+            if (late_prefetch) {
+                perf_analyzer->record_prefetch_useful("L2", true);
+            }
+        }
+        write_back("L2", eviction);
+        run_prefetcher(l2_prefetcher, l2, l2_mshrs, "L2", pc, addr, late_prefetch);
+        
+        uint64_t done = std::max(pending->fill_cycle, start + l2->get_hit_latency());
+        return static_cast<unsigned int>(done - start);
+    }
+    
+    bool hit = l2->access(line, false, eviction);
+    bool prefetch_hit = hit && l2->consume_prefetch(line);
+    
+    if (perf_analyzer) {
+        perf_analyzer->record_cache_access("L2", hit);
+        if (prefetch_hit) {
+            perf_analyzer->record_prefetch_useful("L2", false);
+        }
+    }
+    write_back("L2", eviction);
+    
+    uint64_t done = start + l2->get_hit_latency();
+    if (!hit) {
+        // With every L2 MSHR busy the miss waits for the earliest fill to free one
+        uint64_t issue = done;
+        if (!l2_mshrs->has_free()) {
+            issue = std::max(issue, l2_mshrs->earliest_fill());
+            l2_mshrs->retire(issue);
+            if (perf_analyzer) {
+                perf_analyzer->record_mshr_full("L2");
+            }
+        }
+        
+        done = issue + read_dram(line, issue);
+        l2_mshrs->allocate(line, done);
+    }
+    
+    run_prefetcher(l2_prefetcher, l2, l2_mshrs, "L2", pc, addr, !hit || prefetch_hit);
+    return static_cast<unsigned int>(done - start);
+}
+
+unsigned int MemorySystem::read_dram(Address line, uint64_t start) {
+    RowBufferOutcome outcome;
+    bool queued = false;
+    unsigned int latency = dram->access(line, start, outcome, queued);
+    
+    if (perf_analyzer) {
+        perf_analyzer->record_dram_access(outcome, false, latency, queued);
+    }
+    
+    return latency;
+}
+
+void MemorySystem::run_prefetcher(Prefetcher* prefetcher, Cache* cache, MSHRFile* mshrs,
+                                  const std::string& label, Address pc, Address addr, bool trigger) {
+    if (!prefetcher) {
         return;
     }
     
-    // Little-endian write
-    for (uint8_t i = 0; i < size; i++) {
-        memory[addr + i] = (data >> (i * 8)) & 0xFF;
+    std::vector<Address> candidates;
+    prefetcher->observe(pc, addr, trigger, candidates);
+    
+    for (Address candidate : candidates) {
+        issue_prefetch(cache, mshrs, label, cache->line_address(candidate), pc);
     }
 }
 
-void MemorySystem::load_program(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
+void MemorySystem::issue_prefetch(Cache* cache, MSHRFile* mshrs, const std::string& label,
+                                  Address line, Address pc) {
+    if (cache->probe(line) || mshrs->find(line)) {
+        return;
+    }
     
-    if (!file) {
-        std::cerr << "Error: Could not open program file " << filename << std::endl;
+    // Prefetches never wait for an MSHR; demand misses need them more
+    if (!mshrs->has_free()) {
+        if (perf_analyzer) {
+            perf_analyzer->record_prefetch_dropped(label);
+        }
         return;
     }
     
-    // Read program data
-    file.read(reinterpret_cast<char*>(memory.data()), MEMORY_SIZE);
+    CacheEviction eviction;
+    cache->fill(line, eviction);
+    write_back(label, eviction);
     
-    std::cout << "Loaded " << file.gcount() << " bytes from " << filename << std::endl;
-    file.close();
+    unsigned int latency = cache->get_hit_latency();
+    latency += next_level_latency(cache, line, cycle + latency, pc);
+    mshrs->allocate(line, cycle + latency, true);
+    
+    if (perf_analyzer) {
+        perf_analyzer->record_prefetch_issued(label);
+    }
+}
+
+void MemorySystem::write_back(const std::string& label, const CacheEviction& eviction) {
+    if (!eviction.valid) {
+        return;
+    }
+    
+    if (perf_analyzer) {
+        perf_analyzer->record_cache_eviction(label, eviction.dirty);
+        if (eviction.unused_prefetch) {
+            perf_analyzer->record_prefetch_unused(label);
+        }
+    }
+    
+    if (!eviction.dirty) {
+        return;
+    }
+    
+    // Dirty L1 lines are written into the L2; dirty L2 lines go to memory.
+    // Writebacks are off the critical path but keep DRAM banks busy.
+    if (label != "L2") {
+        CacheEviction l2_eviction;
+        bool hit = l2->access(eviction.line_addr, true, l2_eviction);
+        if (perf_analyzer) {
+            perf_analyzer->record_cache_access("L2", hit);
+        }
+        write_back("L2", l2_eviction);
+    } else {
+        RowBufferOutcome outcome;
+        bool queued = false;
+        unsigned int latency = dram->access(eviction.line_addr, cycle, outcome, queued);
+        if (perf_analyzer) {
+            perf_analyzer->record_dram_access(outcome, true, latency, queued);
+        }
+    }
+}
+
+bool MemorySystem::load_program(const std::string& filename) {
+    delete program;
+    symbols.clear();
+    program = new ElfLoader(filename);
+    
+    if (!program->is_open()) {
+        std::cerr << "Error: Could not open program file " << filename << std::endl;
+        return false;
+    }
+    
+    if (!program->load(*memory, symbols)) {
+        std::cerr << "Error: Could not load ELF file " << filename << std::endl;
+        return false;
+    }
+    
+    if (program->is_elf()) {
+        std::cout << "Loaded ELF " << filename << ": " << program->segments() << " segments, "
+                  << symbols.size() << " symbols, entry 0x" << std::hex << program->entry()
+                  << std::dec << std::endl;
+    } else {
+        std::cout << "Loaded " << program->size() << " bytes from " << filename << std::endl;
+    }
+    
+    return true;
 }
 
 void MemorySystem::memory_proc() {
-    // Memory processing logic
-    // This could include handling memory access queues, latency simulation, etc.
+    if (reset.read()) {
+        cycle = 0;
+        l1i_mshrs->reset();
+        l1d_mshrs->reset();
+        l2_mshrs->reset();
+        dram->reset();
+        if (l1d_prefetcher) l1d_prefetcher->reset();
+        if (l2_prefetcher) l2_prefetcher->reset();
+        if (itlb) {
+            itlb->reset();
+            dtlb->reset();
+            l2tlb->reset();
+            walker->reset();
+            walker_free = 0;
+        }
+        return;
+    }
+    
+    // Free the MSHRs whose lines have arrived
+    cycle++;
+    l1i_mshrs->retire(cycle);
+    l1d_mshrs->retire(cycle);
+    l2_mshrs->retire(cycle);
+    
+    if (perf_analyzer) {
+        perf_analyzer->record_mshr_occupancy("L1I", l1i_mshrs->outstanding());
+        perf_analyzer->record_mshr_occupancy("L1D", l1d_mshrs->outstanding());
+        perf_analyzer->record_mshr_occupancy("L2", l2_mshrs->outstanding());
+    }
 }
@@ -0,0 +1,64 @@
+#include "memory/mshr.h"
+
+MSHRFile::MSHRFile(sc_module_name name, unsigned int entries)
+    : sc_module(name), max_entries(entries > 0 ? entries : 1) {
+    reset();
+}
+
+void MSHRFile::reset() {
+    entries.clear();
+}
+
+void MSHRFile::retire(uint64_t cycle) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->fill_cycle <= cycle) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+MSHREntry* MSHRFile::find(Address line_addr) {
+    for (auto &entry : entries) {
+        if (entry.line_addr == line_addr) {
+            return &entry;
+        }
+    }
+    
+    return nullptr;
+}
+
+const MSHREntry* MSHRFile::find(Address line_addr) const {
+    for (const auto &entry : entries) {
+        if (entry.line_addr == line_addr) {
+            return &entry;
+        }
+    }
+    
+    return nullptr;
+}
+
+uint64_t MSHRFile::earliest_fill() const {
+    uint64_t earliest = 0;
+    for (const auto &entry : entries) {
+        if (earliest == 0 || entry.fill_cycle < earliest) {
+            earliest = entry.fill_cycle;
+        }
+    }
+    
+    return earliest;
+}
+
+void MSHRFile::allocate(Address line_addr, uint64_t fill_cycle, bool prefetch) {
+    if (!has_free()) {
+        return;
+    }
+    
+    MSHREntry entry;
+    entry.line_addr = line_addr;
+    entry.fill_cycle = fill_cycle;
+    entry.targets = prefetch ? 0 : 1;
+    entry.prefetch = prefetch;
+    entries.push_back(entry);
+}
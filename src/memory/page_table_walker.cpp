@@ -0,0 +1,122 @@
+#include "memory/page_table_walker.h"
+
+namespace {
+// Page tables are placed above every identity-mapped Sv39 address
+const Address PAGE_TABLE_BASE = 1ULL << 40;
+
+// Sv39 PTE fields
+const uint64_t PTE_V = 1ULL << 0;
+const uint64_t PTE_R = 1ULL << 1;
+const uint64_t PTE_W = 1ULL << 2;
+const uint64_t PTE_X = 1ULL << 3;
+const uint64_t PTE_A = 1ULL << 6;
+const uint64_t PTE_D = 1ULL << 7;
+const unsigned int PTE_PPN_SHIFT = 10;
+const uint64_t PPN_MASK = (1ULL << 44) - 1;
+}
+
+PageTableWalker::PageTableWalker(sc_module_name name, SparseMemory* memory, unsigned int page_shift,
+                                 unsigned int pwc_entries)
+    : sc_module(name), memory(memory), next_table(PAGE_TABLE_BASE), use_counter(0) {
+    // 12 -> level 0, 21 -> level 1, 30 -> level 2
+    leaf_level = page_shift >= 30 ? 2 : (page_shift >= 21 ? 1 : 0);
+    root = allocate_table();
+    
+    pwc.resize(pwc_entries);
+    reset();
+}
+
+void PageTableWalker::reset() {
+    for (auto &entry : pwc) {
+        entry.valid = false;
+    }
+}
+
+uint64_t PageTableWalker::level_tag(Address vaddr, unsigned int level) {
+    // Only the low 39 bits take part in Sv39 translation
+    return (vaddr & ((1ULL << 39) - 1)) >> (12 + 9 * (level + 1));
+}
+
+Address PageTableWalker::allocate_table() {
+    // Fresh guest pages read as zero, i.e. every PTE invalid
+    Address table = next_table;
+    next_table += SparseMemory::PAGE_SIZE;
+    return table;
+}
+
+unsigned int PageTableWalker::walk(Address vaddr, std::vector<Address>& pte_reads) {
+    // Start from the deepest table the page walk cache knows about
+    unsigned int level = LEVELS - 1;
+    Address table = root;
+    for (unsigned int l = leaf_level; l < LEVELS - 1; l++) {
+        PwcEntry* entry = pwc_lookup(vaddr, l);
+        if (entry) {
+            level = l;
+            table = entry->table;
+            break;
+        }
+    }
+    
+    while (true) {
+        uint64_t vpn = (vaddr >> (12 + 9 * level)) & 0x1FF;
+        Address pte_addr = table + vpn * PTE_SIZE;
+        pte_reads.push_back(pte_addr);
+        
+        uint64_t pte = memory->read(pte_addr, PTE_SIZE);
+        if (level == leaf_level) {
+            if (!(pte & PTE_V)) {
+                // Map the page on first touch, readable, writable and executable
+                uint64_t ppn = (vaddr >> 12) & PPN_MASK & ~((1ULL << (9 * level)) - 1);
+                pte = (ppn << PTE_PPN_SHIFT) | PTE_V | PTE_R | PTE_W | PTE_X | PTE_A | PTE_D;
+                memory->write(pte_addr, pte, PTE_SIZE);
+            }
+            return 12 + 9 * level;
+        }
+        
+        if (!(pte & PTE_V)) {
+            // Pointer to a new next-level table
+            pte = ((allocate_table() >> 12) << PTE_PPN_SHIFT) | PTE_V;
+            memory->write(pte_addr, pte, PTE_SIZE);
+        }
+        
+        table = ((pte >> PTE_PPN_SHIFT) & PPN_MASK) << 12;
+        level--;
+        pwc_insert(vaddr, level, table);
+    }
+}
+
+PageTableWalker::PwcEntry* PageTableWalker::pwc_lookup(Address vaddr, unsigned int level) {
+    uint64_t tag = level_tag(vaddr, level);
+    for (auto &entry : pwc) {
+        if (entry.valid && entry.level == level && entry.tag == tag) {
+            entry.last_use = ++use_counter;
+            return &entry;
+        }
+    }
+    
+    return nullptr;
+}
+
+void PageTableWalker::pwc_insert(Address vaddr, unsigned int level, Address table) {
+    if (pwc.empty() || pwc_lookup(vaddr, level)) {
+        return;
+    }
+    
+    // Fully associative, LRU
+    PwcEntry* victim = &pwc[0];
+    for (auto &entry : pwc) {
+        if (!entry.valid) {
+            victim = &entry;
+            break;
+        }
+        if (entry.last_use < victim->last_use) {
+            victim = &entry;
+        }
+    }
+    
+    victim->valid = true;
+    victim->level = level;
+    victim->tag = level_tag(vaddr, level);
+    victim->table = table;
+    victim->last_use = ++use_counter;
+}
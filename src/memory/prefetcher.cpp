@@ -0,0 +1,157 @@
+#include "memory/prefetcher.h"
+
+// Lines either side of a stream's last miss that still belong to it
+static const int64_t STREAM_WINDOW = 4;
+
+Prefetcher::Prefetcher(sc_module_name name, PrefetcherType type, unsigned int line_size,
+                       unsigned int degree, unsigned int table_size)
+    : sc_module(name),
+      prefetcher_type(type),
+      line_bytes(line_size > 0 ? line_size : 64),
+      prefetch_degree(degree > 0 ? degree : 1),
+      access_count(0) {
+    if (table_size == 0) table_size = 1;
+    
+    stride_table.resize(table_size);
+    streams.resize(table_size < 8 ? table_size : 8);
+    
+    reset();
+}
+
+void Prefetcher::reset() {
+    for (auto &entry : stride_table) {
+        entry.valid = false;
+        entry.pc = 0;
+        entry.last_addr = 0;
+        entry.stride = 0;
+        entry.confidence = 0;
+    }
+    
+    for (auto &stream : streams) {
+        stream.valid = false;
+        stream.last_line = 0;
+        stream.direction = 0;
+        stream.last_use = 0;
+    }
+    
+    access_count = 0;
+}
+
+void Prefetcher::observe(Address pc, Address addr, bool trigger, std::vector<Address>& lines) {
+    access_count++;
+    
+    switch (prefetcher_type) {
+        case PrefetcherType::NEXT_LINE:
+            if (trigger) {
+                Address line = addr - (addr % line_bytes);
+                for (unsigned int i = 1; i <= prefetch_degree; i++) {
+                    lines.push_back(line + i * line_bytes);
+                }
+            }
+            break;
+        
+        case PrefetcherType::STRIDE:
+            observe_stride(pc, addr, lines);
+            break;
+        
+        case PrefetcherType::STREAM:
+            if (trigger) {
+                observe_stream(addr, lines);
+            }
+            break;
+        
+        case PrefetcherType::NONE:
+        default:
+            break;
+    }
+}
+
+void Prefetcher::observe_stride(Address pc, Address addr, std::vector<Address>& lines) {
+    StrideEntry &entry = stride_table[(pc >> 2) % stride_table.size()];
+    
+    if (!entry.valid || entry.pc != pc) {
+        entry.valid = true;
+        entry.pc = pc;
+        entry.last_addr = addr;
+        entry.stride = 0;
+        entry.confidence = 0;
+        return;
+    }
+    
+    int64_t stride = static_cast<int64_t>(addr - entry.last_addr);
+    if (stride == entry.stride) {
+        if (entry.confidence < 3) entry.confidence++;
+    } else if (entry.confidence > 0) {
+        entry.confidence--;
+    } else {
+        entry.stride = stride;
+    }
+    entry.last_addr = addr;
+    
+    if (entry.confidence < 2 || entry.stride == 0) {
+        return;
+    }
+    
+    // Prefetch the lines the next few accesses will touch
+    Address current_line = addr - (addr % line_bytes);
+    for (unsigned int i = 1; i <= prefetch_degree; i++) {
+        Address target = addr + entry.stride * static_cast<int64_t>(i);
+        Address line = target - (target % line_bytes);
+        if (line != current_line && (lines.empty() || lines.back() != line)) {
+            lines.push_back(line);
+        }
+    }
+}
+
+void Prefetcher::observe_stream(Address addr, std::vector<Address>& lines) {
+    int64_t line = static_cast<int64_t>(addr / line_bytes);
+    
+    // Find the stream this miss continues
+    StreamEntry* match = nullptr;
+    for (auto &stream : streams) {
+        int64_t distance = line - stream.last_line;
+        if (stream.valid && distance != 0 &&
+            distance >= -STREAM_WINDOW && distance <= STREAM_WINDOW) {
+            match = &stream;
+            break;
+        }
+    }
+    
+    if (!match) {
+        // Start tracking a new stream in the least recently used slot
+        StreamEntry* victim = &streams[0];
+        for (auto &stream : streams) {
+            if (!stream.valid) {
+                victim = &stream;
+                break;
+            }
+            if (stream.last_use < victim->last_use) {
+                victim = &stream;
+            }
+        }
+        
+        victim->valid = true;
+        victim->last_line = line;
+        victim->direction = 0;
+        victim->last_use = access_count;
+        return;
+    }
+    
+    int direction = line > match->last_line ? 1 : -1;
+    bool confirmed = match->direction == direction;
+    match->direction = direction;
+    match->last_line = line;
+    match->last_use = access_count;
+    
+    // Two steps in the same direction confirm the stream
+    if (!confirmed) {
+        return;
+    }
+    
+    for (unsigned int i = 1; i <= prefetch_degree; i++) {
+        int64_t target = line + direction * static_cast<int64_t>(i);
+        if (target >= 0) {
+            lines.push_back(static_cast<Address>(target) * line_bytes);
+        }
+    }
+}
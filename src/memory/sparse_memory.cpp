@@ -0,0 +1,174 @@
+#include "memory/sparse_memory.h"
+#include <sys/mman.h>
+#include <cstring>
+#include <algorithm>
+#include <new>
+
+namespace {
+// Backs reads of pages that were never written
+alignas(4096) uint8_t zero_page[SparseMemory::PAGE_SIZE];
+}
+
+SparseMemory::SparseMemory(sc_module_name name)
+    : sc_module(name), chunk_used(PAGES_PER_CHUNK) {
+    for (size_t i = 0; i < PAGE_CACHE_ENTRIES; i++) {
+        page_cache[i] = {~0ULL, nullptr, false};
+    }
+}
+
+SparseMemory::~SparseMemory() {
+    for (uint8_t* chunk : chunks) {
+        munmap(chunk, PAGES_PER_CHUNK * PAGE_SIZE);
+    }
+}
+
+uint8_t* SparseMemory::allocate_page() {
+    if (chunk_used == PAGES_PER_CHUNK) {
+        // Reserve address space only; the host supplies zeroed pages on
+        // first touch, so untouched parts of a chunk cost nothing
+        size_t bytes = PAGES_PER_CHUNK * PAGE_SIZE;
+        void* chunk = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (chunk == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(chunk, bytes, MADV_HUGEPAGE);
+#endif
+        chunks.push_back(static_cast<uint8_t*>(chunk));
+        chunk_used = 0;
+    }
+    
+    return chunks.back() + (chunk_used++) * PAGE_SIZE;
+}
+
+uint8_t* SparseMemory::find_page(Address addr) const {
+    auto it = pages.find(addr / PAGE_SIZE);
+    return it == pages.end() ? nullptr : it->second;
+}
+
+uint8_t* SparseMemory::page(Address addr) {
+    uint64_t page_number = addr / PAGE_SIZE;
+    uint8_t* &host = pages[page_number];
+    if (!host) {
+        host = allocate_page();
+        
+        // Drop a cached zero-page translation for this page
+        PageCacheEntry& entry = page_cache[page_number % PAGE_CACHE_ENTRIES];
+        if (entry.page_number == page_number) {
+            entry = {page_number, host, true};
+        }
+    }
+    
+    return host;
+}
+
+void SparseMemory::map(Address addr, uint8_t* host) {
+    uint64_t page_number = addr / PAGE_SIZE;
+    pages[page_number] = host;
+    
+    PageCacheEntry& entry = page_cache[page_number % PAGE_CACHE_ENTRIES];
+    if (entry.page_number == page_number) {
+        entry = {page_number, host, true};
+    }
+}
+
+uint8_t SparseMemory::read_byte(Address addr) const {
+    const uint8_t* host = find_page(addr);
+    return host ? host[addr % PAGE_SIZE] : 0;
+}
+
+void SparseMemory::write_byte(Address addr, uint8_t value) {
+    page(addr)[addr % PAGE_SIZE] = value;
+}
+
+void SparseMemory::load(Address addr, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        size_t offset = addr % PAGE_SIZE;
+        size_t chunk = std::min(size, static_cast<size_t>(PAGE_SIZE - offset));
+        std::memcpy(page(addr) + offset, data, chunk);
+        
+        addr += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+uint8_t* SparseMemory::read_page(Address addr) {
+    uint64_t page_number = addr / PAGE_SIZE;
+    PageCacheEntry& entry = page_cache[page_number % PAGE_CACHE_ENTRIES];
+    if (entry.page_number != page_number) {
+        uint8_t* host = find_page(addr);
+        entry = {page_number, host ? host : zero_page, host != nullptr};
+    }
+    
+    return entry.host;
+}
+
+uint8_t* SparseMemory::write_page(Address addr) {
+    uint64_t page_number = addr / PAGE_SIZE;
+    PageCacheEntry& entry = page_cache[page_number % PAGE_CACHE_ENTRIES];
+    if (entry.page_number != page_number || !entry.writable) {
+        entry = {page_number, page(addr), true};
+    }
+    
+    return entry.host;
+}
+
+uint64_t SparseMemory::read(Address addr, unsigned int size) {
+    size_t offset = addr % PAGE_SIZE;
+    if (offset + size > PAGE_SIZE) {
+        return read_bytes(addr, size);
+    }
+    
+    const uint8_t* src = read_page(addr) + offset;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // Host and guest agree on byte order, so one copy assembles the value
+    switch (size) {
+        case 1: return *src;
+        case 2: { uint16_t v; std::memcpy(&v, src, 2); return v; }
+        case 4: { uint32_t v; std::memcpy(&v, src, 4); return v; }
+        case 8: { uint64_t v; std::memcpy(&v, src, 8); return v; }
+    }
+#endif
+    uint64_t value = 0;
+    for (unsigned int i = 0; i < size; i++) {
+        value |= static_cast<uint64_t>(src[i]) << (i * 8);
+    }
+    return value;
+}
+
+void SparseMemory::write(Address addr, uint64_t value, unsigned int size) {
+    size_t offset = addr % PAGE_SIZE;
+    if (offset + size > PAGE_SIZE) {
+        write_bytes(addr, value, size);
+        return;
+    }
+    
+    uint8_t* dst = write_page(addr) + offset;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    switch (size) {
+        case 1: *dst = static_cast<uint8_t>(value); return;
+        case 2: { uint16_t v = static_cast<uint16_t>(value); std::memcpy(dst, &v, 2); return; }
+        case 4: { uint32_t v = static_cast<uint32_t>(value); std::memcpy(dst, &v, 4); return; }
+        case 8: std::memcpy(dst, &value, 8); return;
+    }
+#endif
+    for (unsigned int i = 0; i < size; i++) {
+        dst[i] = (value >> (i * 8)) & 0xFF;
+    }
+}
+
+uint64_t SparseMemory::read_bytes(Address addr, unsigned int size) {
+    uint64_t value = 0;
+    for (unsigned int i = 0; i < size; i++) {
+        value |= static_cast<uint64_t>(read_byte(addr + i)) << (i * 8);
+    }
+    return value;
+}
+
+void SparseMemory::write_bytes(Address addr, uint64_t value, unsigned int size) {
+    for (unsigned int i = 0; i < size; i++) {
+        write_byte(addr + i, (value >> (i * 8)) & 0xFF);
+    }
+}
@@ -0,0 +1,60 @@
+#include "memory/tlb.h"
+
+namespace {
+// Sv39 page sizes, smallest first
+const unsigned int PAGE_SHIFTS[] = {12, 21, 30};
+}
+
+Tlb::Tlb(sc_module_name name, const TlbConfig& config)
+    : sc_module(name), hit_latency(config.hit_latency), use_counter(0) {
+    unsigned int total = config.entries > 0 ? config.entries : 1;
+    num_ways = config.ways > 0 && config.ways <= total ? config.ways : total;
+    num_sets = total / num_ways;
+    
+    entries.resize(num_sets * num_ways);
+    reset();
+}
+
+void Tlb::reset() {
+    for (auto &entry : entries) {
+        entry.valid = false;
+    }
+}
+
+TlbEntry* Tlb::lookup(Address vaddr) {
+    for (unsigned int shift : PAGE_SHIFTS) {
+        uint64_t vpn = vaddr >> shift;
+        TlbEntry* set = &entries[(vpn % num_sets) * num_ways];
+        for (unsigned int way = 0; way < num_ways; way++) {
+            if (set[way].valid && set[way].page_shift == shift && set[way].vpn == vpn) {
+                set[way].last_use = ++use_counter;
+                return &set[way];
+            }
+        }
+    }
+    
+    return nullptr;
+}
+
+void Tlb::insert(Address vaddr, unsigned int page_shift, uint64_t ready_cycle) {
+    uint64_t vpn = vaddr >> page_shift;
+    TlbEntry* set = &entries[(vpn % num_sets) * num_ways];
+    
+    // Prefer an invalid way, otherwise the least recently used
+    TlbEntry* victim = &set[0];
+    for (unsigned int way = 0; way < num_ways; way++) {
+        if (!set[way].valid) {
+            victim = &set[way];
+            break;
+        }
+        if (set[way].last_use < victim->last_use) {
+            victim = &set[way];
+        }
+    }
+    
+    victim->valid = true;
+    victim->vpn = vpn;
+    victim->page_shift = page_shift;
+    victim->ready_cycle = ready_cycle;
+    victim->last_use = ++use_counter;
+}
@@ -11,10 +11,10 @@ void WritebackUnit::writeback_proc() {
         return;
     }
     
-    // Get execute packet
-    ExecutePacket exec_packet = execute_in.read();
+    // Get the branches resolved last cycle
+    ExecuteBundle exec_bundle = execute_in.read();
     
-    if (!exec_packet.valid) {
+    if (exec_bundle.count == 0) {
         return;
     }
     
@@ -0,0 +1,76 @@
+# RISC-V Assembly Test Program: Macro-op Fusion Test
+# This program exercises the instruction pairs decode can fuse: constant and
+# address materialization, calls, zero-extension and compare-and-branch
+# (build with -march=rv64i -mabi=lp64, run with --fusion on)
+
+.text
+.globl _start
+
+_start:
+    # Test 1: lui + addi/addiw build 32-bit constants
+    lui x5, 0x12345
+    addi x5, x5, 0x678     # x5 = 0x12345678
+    lui x6, 0x80000
+    addi x6, x6, -1        # x6 = 0xffffffff7fffffff (no fusion: out of int32 range)
+    lui x7, 0x7ffff
+    addiw x7, x7, 0x7ff    # x7 = 0x7ffff7ff
+    lui x8, 0x80000
+    addiw x8, x8, -1       # x8 = 0x7fffffff (word wrap)
+    
+    # Test 2: auipc + addi form a PC-relative address
+    la x9, data            # x9 = &data
+    ld x10, 0(x9)          # x10 = 0x1122334455667788
+    
+    # Test 3: auipc + jalr is a direct call
+    li x11, 0
+    call add_five          # x11 = 5
+    call add_five          # x11 = 10
+    
+    # Test 4: slli + srli zero-extends, slli + srai sign-extends
+    li x12, -2
+    slli x13, x12, 32
+    srli x13, x13, 32      # x13 = 0xfffffffe
+    slli x14, x12, 48
+    srai x14, x14, 56      # x14 = -1
+    slli x15, x10, 8
+    srli x15, x15, 40      # x15 = 0x223344
+    
+    # Test 5: slt/sltu + beqz/bnez, the compare result is still written
+    li x16, 0              # Taken branch count
+    li x17, -3
+    li x18, 4
+    slt x19, x17, x18      # x19 = 1
+    bnez x19, 1f
+    addi x16, x16, 100
+1:  addi x16, x16, 1
+    sltu x20, x17, x18     # x20 = 0 (unsigned -3 is large)
+    beqz x20, 2f
+    addi x16, x16, 100
+2:  addi x16, x16, 1
+    # x16 = 2
+
+    # Test 6: a counted loop closed by a fused compare-and-branch
+    li x21, 0              # Sum
+    li x22, 0              # Counter
+    li x23, 20
+sum_loop:
+    add x21, x21, x22
+    addi x22, x22, 1
+    slt x24, x22, x23
+    bnez x24, sum_loop
+    # x21 = 190, x24 = 0
+
+    # End of program
+    j end
+
+add_five:
+    addi x11, x11, 5
+    ret
+
+end:
+    j end  # Infinite loop to halt
+
+.data
+.align 3
+data:
+    .dword 0x1122334455667788
@@ -0,0 +1,65 @@
+# RISC-V Assembly Test Program: M Extension Test
+# This program tests multiply, divide and remainder, including the word forms,
+# division by zero and signed overflow (build with -march=rv64im -mabi=lp64)
+
+.text
+.globl _start
+
+_start:
+    # Initialize registers
+    li x1, -7
+    li x2, 3
+    li x3, -1
+    li x4, 1
+    slli x4, x4, 63    # x4 = INT64_MIN
+
+    # Test 1: Multiplies
+    mul x5, x1, x2     # x5 = -21
+    mulh x6, x3, x3    # x6 = 0 (high half of 1)
+    mulhu x7, x3, x3   # x7 = 0xfffffffffffffffe
+    mulhsu x8, x3, x3  # x8 = -1
+    mulw x9, x4, x2    # x9 = 0 (low word of INT64_MIN is 0)
+
+    # Test 2: Divides and remainders round toward zero
+    div x10, x1, x2    # x10 = -2
+    rem x11, x1, x2    # x11 = -1
+    divu x12, x3, x2   # x12 = 0x5555555555555555
+    remu x13, x3, x2   # x13 = 0
+
+    # Test 3: Division by zero and overflow do not trap
+    div x14, x1, x0    # x14 = -1
+    rem x15, x1, x0    # x15 = -7
+    div x16, x4, x3    # x16 = INT64_MIN
+    rem x17, x4, x3    # x17 = 0
+
+    # Test 4: Word forms sign-extend their 32-bit result
+    li x18, 100
+    divw x19, x18, x1  # x19 = -14
+    remuw x20, x1, x18 # x20 = 89 (0xfffffff9 % 100)
+    divuw x21, x3, x2  # x21 = 0x55555555
+
+    # Test 5: Factorial of 10 with a dependent multiply chain,
+    # then divide it back down
+    li x22, 1          # Product
+    li x23, 1          # Counter
+    li x24, 11         # Loop limit
+fact_loop:
+    mul x22, x22, x23
+    addi x23, x23, 1
+    blt x23, x24, fact_loop
+    # x22 = 3628800
+
+    li x23, 1
+    mv x25, x22
+undo_loop:
+    divu x25, x25, x23
+    addi x23, x23, 1
+    blt x23, x24, undo_loop
+    # x25 = 1
+    remw x26, x22, x18 # x26 = 0
+
+    # End of program
+    j end
+
+end:
+    j end  # Infinite loop to halt
@@ -0,0 +1,70 @@
+# RISC-V Assembly Test Program: RV64I Test
+# This program tests doubleword loads/stores, LWU and the W-form operations
+# (build with -march=rv64i -mabi=lp64)
+
+.text
+.globl _start
+
+_start:
+    # Initialize registers
+    li x1, 0x1000      # Base memory address
+    li x2, -1          # All ones
+    li x6, 0x7fffffff  # Largest positive word
+
+    # Test 1: Doubleword and unsigned word loads
+    sd x2, 0(x1)       # Store 64 bits of ones
+    ld x3, 0(x1)       # x3 = -1
+    lwu x4, 0(x1)      # x4 = 0x00000000ffffffff (zero-extended)
+    lw x5, 4(x1)       # x5 = -1 (sign-extended)
+
+    # Test 2: Word operations sign-extend their 32-bit result
+    addiw x7, x6, 1    # x7 = 0xffffffff80000000 (overflow wraps)
+    addw x8, x6, x6    # x8 = -2
+    subw x9, x0, x6    # x9 = 0xffffffff80000001
+    slliw x10, x6, 4   # x10 = -16
+    srliw x11, x2, 4   # x11 = 0x0fffffff (upper word ignored)
+    sraiw x12, x7, 4   # x12 = 0xfffffffff8000000
+    li x13, 36
+    sllw x14, x6, x13  # Shift amount uses the low 5 bits: x14 = -16
+    srlw x15, x7, x13  # x15 = 0x08000000
+    sraw x16, x7, x13  # x16 = 0xfffffffff8000000
+
+    # Test 3: 64-bit shifts
+    slli x17, x6, 32   # x17 = 0x7fffffff00000000
+    srai x18, x17, 32  # x18 = 0x7fffffff
+    srli x19, x2, 60   # x19 = 0xf
+    srai x20, x2, 60   # x20 = -1
+
+    # Test 4: Fill an array with doublewords (i << 33) and sum it back
+    li x21, 0          # Counter
+    li x22, 16         # Loop limit
+    addi x23, x1, 64   # Array base
+fill_loop:
+    slli x24, x21, 33
+    slli x25, x21, 3
+    add x25, x23, x25
+    sd x24, 0(x25)
+    addi x21, x21, 1
+    blt x21, x22, fill_loop
+
+    li x21, 0
+    li x26, 0          # Sum
+sum_loop:
+    slli x25, x21, 3
+    add x25, x23, x25
+    ld x24, 0(x25)
+    add x26, x26, x24
+    addi x21, x21, 1
+    blt x21, x22, sum_loop
+    # x26 = 120 << 33 = 0xf000000000
+
+    # Test 5: Store a word into a doubleword and read the whole doubleword
+    sd x0, 0(x1)
+    sw x6, 4(x1)
+    ld x27, 0(x1)      # x27 = 0x7fffffff00000000
+
+    # End of program
+    j end
+
+end:
+    j end  # Infinite loop to halt
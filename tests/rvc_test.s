@@ -0,0 +1,75 @@
+# RISC-V Assembly Test Program: Compressed Instruction Test
+# This program mixes 16-bit and 32-bit instructions, including 32-bit
+# instructions that straddle a cache line boundary
+# (build with -march=rv64ic -mabi=lp64)
+
+.text
+.globl _start
+
+_start:
+    # Initialize registers
+    li x2, 0x2000      # Stack pointer
+    li x8, 0x1000      # Base memory address
+    li x9, 0           # Sum
+    li x10, 10         # Loop counter
+
+    # Test 1: Compressed ALU operations and a compressed loop branch
+sum_loop:
+    add x9, x9, x10    # c.add
+    addi x10, x10, -1  # c.addi
+    bnez x10, sum_loop # c.bnez
+    # x9 = 55
+
+    # Test 2: Compressed loads and stores, word and doubleword
+    sw x9, 0(x8)       # c.sw
+    sd x9, 8(x8)       # c.sd
+    lw x11, 0(x8)      # c.lw
+    ld x12, 8(x8)      # c.ld
+    sd x12, 16(x2)     # c.sdsp
+    ld x13, 16(x2)     # c.ldsp
+    # x11 = x12 = x13 = 55
+
+    # Test 3: Compressed register-register and immediate operations
+    mv x14, x9         # c.mv
+    slli x14, x14, 4   # c.slli: x14 = 880
+    srli x14, x14, 2   # c.srli: x14 = 220
+    andi x14, x14, 0x3c # c.andi: x14 = 28
+    li x15, -1
+    srai x15, x15, 3   # c.srai: x15 = -1
+    sub x15, x14, x15  # c.sub: x15 = 29
+    xor x11, x11, x15  # c.xor: x11 = 55 ^ 29 = 42
+    addiw x12, x12, 1  # c.addiw: x12 = 56
+    addw x12, x12, x14 # c.addw: x12 = 84
+
+    # Test 4: Calls and returns through compressed jumps
+    li x16, 0
+    call add_three     # ra = return address after a 4-byte jal
+    call add_three
+    # x16 = 6
+    j skip             # c.j
+    li x16, -1         # Skipped
+skip:
+
+    # Test 5: A loop whose 32-bit instructions cross cache line boundaries
+    li x17, 0
+    li x18, 100
+    .balign 64
+    .rept 31
+    nop                # c.nop: pads to the last halfword of the line
+    .endr
+line_loop:
+    addi x17, x17, 100 # 32-bit, straddles the line boundary
+    addi x17, x17, -99 # 32-bit
+    addi x18, x18, -1  # c.addi
+    bnez x18, line_loop # 32-bit (x18 is outside the compressed register set)
+    # x17 = 100
+
+    # End of program
+    j end
+
+add_three:
+    addi x16, x16, 3   # c.addi
+    ret                # c.jr ra
+
+end:
+    j end  # Infinite loop to halt